@@ -10,6 +10,7 @@
 
 #include "base/base64url.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
@@ -94,22 +95,29 @@ void OnBeforeURLRequestAdBlockTPOnTaskRunner(
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
+  // Serialize the URL and classify it as first- or third-party once, and
+  // share the result between the default, regional and custom lists.
   bool did_match_exception = false;
   std::string tab_host = ctx->tab_origin.host();
+  const std::string& url_spec = ctx->request_url.spec();
+  bool is_third_party = brave_shields::AdBlockBaseService::IsThirdPartyRequest(
+      ctx->request_url, tab_host);
   if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
+          url_spec, ctx->resource_type, tab_host, is_third_party,
           &did_match_exception, &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(url_spec, ctx->resource_type,
+                                       tab_host, is_third_party,
+                                       &did_match_exception,
                                        &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(url_spec, ctx->resource_type,
+                                       tab_host, is_third_party,
+                                       &did_match_exception,
                                        &ctx->cancel_request_explicitly)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
@@ -121,9 +129,53 @@ void OnBeforeURLRequestAdBlockTPOnTaskRunner(
   }
 }
 
-void OnBeforeURLRequestDispatchOnIOThread(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
+// Decides the request from cached ad-block decisions and the tracker list
+// alone, without a round trip to the thread pool. Returns false if any list
+// that would be consulted has not seen the request before.
+bool GetCachedAdBlockTPDecision(std::shared_ptr<BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!ctx->tab_origin.has_host()) {
+    return false;
+  }
+
+  std::string tab_host = ctx->tab_origin.host();
+  const std::string& url_spec = ctx->request_url.spec();
+  bool is_third_party = brave_shields::AdBlockBaseService::IsThirdPartyRequest(
+      ctx->request_url, tab_host);
+  brave_shields::AdBlockDecisionCache::Decision decision;
+  if (!g_brave_browser_process->ad_block_service()->GetCachedDecision(
+          url_spec, ctx->resource_type, tab_host, is_third_party,
+          &decision)) {
+    return false;
+  }
+  if (decision.should_start_request && !decision.did_match_exception &&
+      !g_brave_browser_process->ad_block_regional_service_manager()
+           ->GetCachedDecision(url_spec, ctx->resource_type, tab_host,
+                               is_third_party, &decision)) {
+    return false;
+  }
+  if (decision.should_start_request && !decision.did_match_exception &&
+      !g_brave_browser_process->ad_block_custom_filters_service()
+           ->GetCachedDecision(url_spec, ctx->resource_type, tab_host,
+                               is_third_party, &decision)) {
+    return false;
+  }
+  if (decision.should_start_request && !decision.did_match_exception &&
+      g_brave_browser_process->tracking_protection_service()->MatchesTracker(
+          ctx->request_url, tab_host)) {
+    return false;
+  }
+
+  if (!decision.should_start_request) {
+    ctx->blocked_by = kAdBlocked;
+    if (decision.cancel_request_explicitly) {
+      ctx->cancel_request_explicitly = true;
+    }
+  }
+  return true;
+}
+
+void DispatchBlockedEventOnIOThread(std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
   if (ctx->blocked_by == kAdBlocked) {
     brave_shields::DispatchBlockedEventFromIO(ctx->request_url,
@@ -134,7 +186,13 @@ void OnBeforeURLRequestDispatchOnIOThread(
         ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
         brave_shields::kTrackers);
   }
+}
 
+void OnBeforeURLRequestDispatchOnIOThread(
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  DispatchBlockedEventOnIOThread(ctx);
   next_callback.Run();
 }
 
@@ -168,11 +226,21 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
-  g_brave_browser_process->ad_block_service()->
-        GetTaskRunner()->PostTaskAndReply(FROM_HERE,
-          base::Bind(&OnBeforeURLRequestAdBlockTPOnTaskRunner, ctx),
-          base::Bind(base::IgnoreResult(
-              &OnBeforeURLRequestDispatchOnIOThread), next_callback, ctx));
+  // Repeated requests are answered inline from the decision caches.
+  if (GetCachedAdBlockTPDecision(ctx)) {
+    DispatchBlockedEventOnIOThread(ctx);
+    return net::OK;
+  }
+
+  // The ad-block and tracking protection matchers are safe for concurrent
+  // use, so requests are matched in parallel rather than queueing behind
+  // each other on the shields task runner.
+  base::PostTaskWithTraitsAndReply(FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&OnBeforeURLRequestAdBlockTPOnTaskRunner, ctx),
+      base::BindOnce(base::IgnoreResult(
+          &OnBeforeURLRequestDispatchOnIOThread), next_callback, ctx));
 
   return net::ERR_IO_PENDING;
 }
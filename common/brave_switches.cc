@@ -55,4 +55,14 @@ const char kDisableEncryptionWin[] = "disable-encryption-win";
 const char kEnableSmartTrackingProtection[] =
     "enable-smart-tracking-protection";
 
+// Memory-maps ad-block DAT files read-only and deserializes them in place
+// instead of reading them into a private heap buffer per list.
+const char kEnableAdBlockMemoryMappedDAT[] =
+    "enable-ad-block-memory-mapped-dat";
+
+// Overrides the number of HTTPS Everywhere lookups, including URLs that are
+// not upgradable, kept in memory.
+const char kHTTPSEverywhereResultCacheSize[] =
+    "https-everywhere-result-cache-size";
+
 }  // namespace switches
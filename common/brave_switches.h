@@ -38,6 +38,10 @@ extern const char kDisableEncryptionWin[];
 
 extern const char kEnableSmartTrackingProtection[];
 
+extern const char kEnableAdBlockMemoryMappedDAT[];
+
+extern const char kHTTPSEverywhereResultCacheSize[];
+
 }  // namespace switches
 
 #endif  // BRAVE_COMMON_BRAVE_SWITCHES_H_
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/containers/flat_map.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
 #include "base/guid.h"
@@ -251,6 +252,21 @@ bool ResetOnFileTaskRunner(
   return base::DeleteFile(path, false);
 }
 
+// Owns the pipes until bat ads has answered, so that it does not depend on the
+// ads service, which may be gone by then
+void OnShutdownBatAds(
+    bat_ads::mojom::BatAdsServicePtr bat_ads_service,
+    bat_ads::mojom::BatAdsAssociatedPtr bat_ads,
+    const base::FilePath& base_path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    const base::flat_map<std::string, std::string>& pending_state) {
+  for (const auto& state : pending_state) {
+    base::ImportantFileWriter writer(
+        base_path.AppendASCII(state.first), file_task_runner);
+    writer.WriteNow(std::make_unique<std::string>(state.second));
+  }
+}
+
 bool SaveBundleStateOnFileTaskRunner(
     std::unique_ptr<ads::BundleState> bundle_state,
     BundleStateDatabase* backend) {
@@ -328,6 +344,8 @@ void AdsServiceImpl::OnCreate() {
 }
 
 void AdsServiceImpl::MaybeStart(bool should_restart) {
+  // A bat ads that is still saving its state after a Stop() keeps its own
+  // pipes until it is done, so it is not cancelled by starting a new one
   if (should_restart)
     Shutdown();
 
@@ -617,8 +635,7 @@ void AdsServiceImpl::Shutdown() {
   fetchers_.clear();
   idle_poll_timer_.Stop();
 
-  bat_ads_.reset();
-  bat_ads_client_binding_.Close();
+  ShutdownBatAds();
 
   for (NotificationInfoMap::iterator it = notification_ids_.begin();
       it != notification_ids_.end(); ++it) {
@@ -629,6 +646,34 @@ void AdsServiceImpl::Shutdown() {
   notification_ids_.clear();
 }
 
+void AdsServiceImpl::ShutdownBatAds() {
+  if (!connected()) {
+    ResetBatAds();
+    return;
+  }
+
+  // Bat ads answers with the state it has yet to save. The answer is handed
+  // the pipes rather than bound to |this|, so that the state is still written
+  // when this service is destroyed straight after shutting down
+  bat_ads_service_.set_connection_error_handler(base::Closure());
+  bat_ads::mojom::BatAds* bat_ads = bat_ads_.get();
+  bat_ads->Shutdown(base::BindOnce(&OnShutdownBatAds,
+      std::move(bat_ads_service_), std::move(bat_ads_), base_path_,
+      file_task_runner_));
+  bat_ads_client_binding_.Close();
+}
+
+void AdsServiceImpl::StartForTesting(
+    bat_ads::mojom::BatAdsServicePtr bat_ads_service) {
+  bat_ads_service_ = std::move(bat_ads_service);
+  Start();
+}
+
+void AdsServiceImpl::ResetBatAds() {
+  bat_ads_.reset();
+  bat_ads_client_binding_.Close();
+}
+
 void AdsServiceImpl::MigratePrefs() const {
   auto source_version = GetPrefsVersion();
   auto dest_version = prefs::kBraveAdsPrefsCurrentVersion;
@@ -1051,7 +1096,7 @@ void AdsServiceImpl::OnShow(Profile* profile,
     return;
 
   bat_ads_->GenerateAdReportingNotificationShownEvent(
-      notification_ids_[notification_id]->ToJson());
+      *notification_ids_[notification_id]);
 }
 
 void AdsServiceImpl::OnClose(Profile* profile,
@@ -1069,7 +1114,7 @@ void AdsServiceImpl::OnClose(Profile* profile,
           ? ads::NotificationResultInfoResultType::DISMISSED
           : ads::NotificationResultInfoResultType::TIMEOUT;
       bat_ads_->GenerateAdReportingNotificationResultEvent(
-          notification_info->ToJson(),
+          *notification_info,
           ToMojomNotificationResultInfoResultType(result_type));
     }
   }
@@ -1097,7 +1142,7 @@ void AdsServiceImpl::OpenSettings(Profile* profile,
 
   if (connected()) {
     bat_ads_->GenerateAdReportingNotificationResultEvent(
-        notification_info->ToJson(),
+        *notification_info,
         ToMojomNotificationResultInfoResultType(
             ads::NotificationResultInfoResultType::CLICKED));
   }
@@ -83,6 +83,9 @@ class AdsServiceImpl : public AdsService,
   uint64_t GetAdsPerHour() const override;
   uint64_t GetAdsPerDay() const override;
 
+  // Starts bat ads through |bat_ads_service| instead of the utility process
+  void StartForTesting(bat_ads::mojom::BatAdsServicePtr bat_ads_service);
+
  private:
   friend class AdsNotificationHandler;
 
@@ -192,6 +195,8 @@ class AdsServiceImpl : public AdsService,
   void OnPrefsChanged(const std::string& pref);
   void OnCreate();
   void OnInitialize();
+  void ShutdownBatAds();
+  void ResetBatAds();
   void MaybeStart(bool should_restart);
   void OnMaybeStartForRegion(
       bool should_restart,
@@ -4,11 +4,16 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <string>
+#include <utility>
 
+#include "base/containers/flat_map.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "extensions/browser/test_event_router.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_ads/browser/test_util.h"
@@ -17,7 +22,10 @@
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom-test-utils.h"
 #include "components/prefs/pref_service.h"
+#include "mojo/public/cpp/bindings/associated_binding.h"
+#include "mojo/public/cpp/bindings/binding.h"
 
 // npm run test -- brave_unit_tests --filter=AdsServiceTest.*
 
@@ -25,6 +33,7 @@ using brave_rewards::RewardsService;
 using brave_rewards::RewardsServiceFactory;
 using brave_ads::AdsService;
 using brave_ads::AdsServiceFactory;
+using brave_ads::AdsServiceImpl;
 
 using ::testing::_;
 
@@ -146,6 +155,90 @@ class MockRewardsService : public RewardsService {
   const brave_rewards::RewardsNotificationService::RewardsNotificationsMap&());
 };
 
+// Answers Shutdown() with |pending_state|
+class FakeBatAds : public bat_ads::mojom::BatAdsInterceptorForTesting {
+ public:
+  explicit FakeBatAds(
+      const base::flat_map<std::string, std::string>& pending_state)
+      : pending_state_(pending_state) {}
+  ~FakeBatAds() override {}
+
+  bat_ads::mojom::BatAds* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void Initialize(InitializeCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void Shutdown(ShutdownCallback callback) override {
+    std::move(callback).Run(pending_state_);
+  }
+
+ private:
+  base::flat_map<std::string, std::string> pending_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeBatAds);
+};
+
+class FakeBatAdsService : public bat_ads::mojom::BatAdsService {
+ public:
+  explicit FakeBatAdsService(
+      const base::flat_map<std::string, std::string>& pending_state)
+      : binding_(this),
+        bat_ads_(pending_state),
+        bat_ads_binding_(&bat_ads_) {}
+  ~FakeBatAdsService() override {}
+
+  bat_ads::mojom::BatAdsServicePtr Bind() {
+    bat_ads::mojom::BatAdsServicePtr bat_ads_service;
+    binding_.Bind(mojo::MakeRequest(&bat_ads_service));
+    return bat_ads_service;
+  }
+
+  void Create(
+      bat_ads::mojom::BatAdsClientAssociatedPtrInfo client_info,
+      bat_ads::mojom::BatAdsAssociatedRequest bat_ads,
+      CreateCallback callback) override {
+    bat_ads_client_.Bind(std::move(client_info));
+    bat_ads_binding_.Bind(std::move(bat_ads));
+    std::move(callback).Run();
+  }
+
+  void SetProduction(
+      const bool is_production,
+      SetProductionCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void SetTesting(
+      const bool is_testing,
+      SetTestingCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void SetDebug(
+      const bool is_debug,
+      SetDebugCallback callback) override {
+    std::move(callback).Run();
+  }
+
+  void IsSupportedRegion(
+      const std::string& locale,
+      IsSupportedRegionCallback callback) override {
+    std::move(callback).Run(true);
+  }
+
+ private:
+  mojo::Binding<bat_ads::mojom::BatAdsService> binding_;
+  FakeBatAds bat_ads_;
+  mojo::AssociatedBinding<bat_ads::mojom::BatAds> bat_ads_binding_;
+  bat_ads::mojom::BatAdsClientAssociatedPtr bat_ads_client_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeBatAdsService);
+};
+
 class AdsServiceTest : public testing::Test {
  public:
   AdsServiceTest() {}
@@ -171,9 +264,16 @@ class AdsServiceTest : public testing::Test {
     delete rewards_service_;
   }
 
+  // Shuts down and destroys the ads service along with the profile
+  void DestroyProfile() {
+    profile_.reset();
+  }
+
   Profile* profile() { return profile_.get(); }
   AdsService* ads_service() { return ads_service_; }
   MockRewardsService* rewards_service() { return rewards_service_; }
+  const base::FilePath& profile_path() { return temp_dir_.GetPath(); }
+  void RunUntilIdle() { thread_bundle_.RunUntilIdle(); }
 
  private:
   content::TestBrowserThreadBundle thread_bundle_;
@@ -181,3 +281,22 @@ class AdsServiceTest : public testing::Test {
   base::ScopedTempDir temp_dir_;
   MockRewardsService* rewards_service_;
 };
+
+TEST_F(AdsServiceTest, SavesPendingStateWhenDestroyedAfterShutdown) {
+  // Arrange
+  const std::string state = "{\"adsShownHistory\":[]}";
+  FakeBatAdsService bat_ads_service({{"client.json", state}});
+  static_cast<AdsServiceImpl*>(ads_service())->StartForTesting(
+      bat_ads_service.Bind());
+  RunUntilIdle();
+
+  // Act
+  DestroyProfile();
+  RunUntilIdle();
+
+  // Assert
+  std::string value;
+  ASSERT_TRUE(base::ReadFileToString(profile_path()
+      .AppendASCII("ads_service").AppendASCII("client.json"), &value));
+  EXPECT_EQ(state, value);
+}
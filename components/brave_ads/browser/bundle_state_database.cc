@@ -8,11 +8,14 @@
 #include <stdint.h>
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -22,8 +25,11 @@ namespace brave_ads {
 
 namespace {
 
-const int kCurrentVersionNumber = 2;
-const int kCompatibleVersionNumber = 2;
+const int kCurrentVersionNumber = 3;
+const int kCompatibleVersionNumber = 3;
+
+const char kCatalogIdKey[] = "catalog_id";
+const char kCatalogVersionKey[] = "catalog_version";
 
 }  // namespace
 
@@ -63,6 +69,17 @@ bool BundleStateDatabase::Init() {
   if (version_status != sql::INIT_OK)
     return false;
 
+  // Ads can't be looked up in a database left at an older version by a
+  // failed migration. They are only a copy of the catalog, so they are
+  // dropped and saved again with the next catalog
+  if (GetMetaTable().GetVersionNumber() < GetCurrentVersion() &&
+      !ResetAdInfoTables())
+    return false;
+
+  // Indexes columns which older databases only have once migrated
+  if (!CreateAdInfoTimestampIndex())
+    return false;
+
   if (!committer.Commit())
     return false;
 
@@ -90,21 +107,6 @@ bool BundleStateDatabase::CreateCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM category"));
-  return sql.Run();
-}
-
-
 bool BundleStateDatabase::CreateAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -112,7 +114,7 @@ bool BundleStateDatabase::CreateAdInfoTable() {
   if (GetDB().DoesTableExist(name))
     return true;
 
-  // Update InsertOrUpdateAdInfo() if you add anything here
+  // Update InsertOrUpdateAdInfo() and HasAdInfo() if you add anything here
   std::string sql;
   sql.append("CREATE TABLE ");
   sql.append(name);
@@ -130,24 +132,12 @@ bool BundleStateDatabase::CreateAdInfoTable() {
       "daily_cap INTEGER DEFAULT 0 NOT NULL,"
       "per_day INTEGER DEFAULT 0 NOT NULL,"
       "total_max INTEGER DEFAULT 0 NOT NULL,"
+      "start_timestamp_in_seconds INTEGER,"
+      "end_timestamp_in_seconds INTEGER,"
       "PRIMARY KEY(region, uuid))");
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM ad_info"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -174,26 +164,41 @@ bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoCategoryTable() {
+bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS ad_info_category_category_name_index "
+      "ON ad_info_category (category_name)");
+}
 
-  if (!initialized)
-    return false;
+bool BundleStateDatabase::CreateAdInfoTimestampIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "DELETE FROM ad_info_category"));
-  return sql.Run();
+  // Ads for a category are looked up by uuid and filtered by date range
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS ad_info_timestamp_index "
+      "ON ad_info (uuid, start_timestamp_in_seconds, "
+      "end_timestamp_in_seconds)");
 }
 
-bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
+bool BundleStateDatabase::ResetAdInfoTables() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  return GetDB().Execute(
-      "CREATE INDEX IF NOT EXISTS ad_info_category_category_name_index "
-      "ON ad_info_category (category_name)");
+  if (!GetDB().Execute("DROP TABLE IF EXISTS ad_info_category") ||
+      !GetDB().Execute("DROP TABLE IF EXISTS ad_info") ||
+      !CreateAdInfoTable() ||
+      !CreateAdInfoCategoryTable() ||
+      !CreateAdInfoCategoryNameIndex())
+    return false;
+
+  // Saves the next catalog in full
+  if (!GetMetaTable().DeleteKey(kCatalogIdKey) ||
+      !GetMetaTable().DeleteKey(kCatalogVersionKey))
+    return false;
+
+  GetMetaTable().SetVersionNumber(GetCurrentVersion());
+  return GetMetaTable().SetCompatibleVersionNumber(kCompatibleVersionNumber);
 }
 
 bool BundleStateDatabase::SaveBundleState(
@@ -206,44 +211,197 @@ bool BundleStateDatabase::SaveBundleState(
   if (!initialized)
     return false;
 
+  if (IsCatalogSaved(bundle_state.catalog_id, bundle_state.catalog_version))
+    return true;
+
+  // Ads are listed under each of their categories, but are only written once
+  // per region
+  std::set<std::string> categories;
+  std::map<AdInfoKey, const ads::AdInfo*> ad_infos;
+  std::set<AdInfoCategoryKey> ad_info_categories;
+  for (const auto& category : bundle_state.categories) {
+    categories.insert(category.first);
+
+    for (const auto& ad_info : category.second) {
+      for (const auto& region : ad_info.regions) {
+        ad_infos[{region, ad_info.uuid}] = &ad_info;
+      }
+
+      ad_info_categories.insert({ad_info.uuid, category.first});
+    }
+  }
+
   if (!GetDB().BeginTransaction())
     return false;
 
-  // we are completely replacing here so first truncate all the tables
-  if (!TruncateAdInfoCategoryTable() ||
-      !TruncateAdInfoTable() ||
-      !TruncateCategoryTable()) {
+  // Only rows which differ from the previous catalog are written
+  if (!UpdateCategories(categories) ||
+      !UpdateAdInfos(ad_infos) ||
+      !UpdateAdInfoCategories(ad_info_categories) ||
+      !SetCatalogSaved(bundle_state.catalog_id, bundle_state.catalog_version)) {
     GetDB().RollbackTransaction();
     return false;
   }
 
-  auto categories = bundle_state.categories;
-  for (std::map<std::string, std::vector<ads::AdInfo>>::iterator it =
-      categories.begin();  it != categories.end(); ++it) {
-    auto category = it->first;
-    if (!InsertOrUpdateCategory(category)) {
-      GetDB().RollbackTransaction();
+  return GetDB().CommitTransaction();
+}
+
+bool BundleStateDatabase::IsCatalogSaved(
+    const std::string& catalog_id,
+    const uint64_t catalog_version) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::string saved_catalog_id;
+  int64_t saved_catalog_version;
+  if (!GetMetaTable().GetValue(kCatalogIdKey, &saved_catalog_id) ||
+      !GetMetaTable().GetValue(kCatalogVersionKey, &saved_catalog_version))
+    return false;
+
+  return saved_catalog_id == catalog_id &&
+      saved_catalog_version == static_cast<int64_t>(catalog_version);
+}
+
+bool BundleStateDatabase::SetCatalogSaved(
+    const std::string& catalog_id,
+    const uint64_t catalog_version) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return GetMetaTable().SetValue(kCatalogIdKey, catalog_id) &&
+      GetMetaTable().SetValue(kCatalogVersionKey,
+          static_cast<int64_t>(catalog_version));
+}
+
+bool BundleStateDatabase::UpdateCategories(
+    const std::set<std::string>& categories) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::set<std::string> saved_categories;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT name FROM category"));
+  while (select_statement.Step()) {
+    saved_categories.insert(select_statement.ColumnString(0));
+  }
+
+  if (!select_statement.Succeeded())
+    return false;
+
+  for (const auto& category : saved_categories) {
+    if (categories.find(category) != categories.end())
+      continue;
+
+    if (!DeleteCategory(category))
+      return false;
+  }
+
+  for (const auto& category : categories) {
+    if (saved_categories.find(category) != saved_categories.end())
+      continue;
+
+    if (!InsertOrUpdateCategory(category))
       return false;
-    }
+  }
 
-    auto ads = it->second;
-    for (std::vector<ads::AdInfo>::iterator ad_it = ads.begin();
-        ad_it != ads.end(); ++ad_it) {
-      auto ad_info = *ad_it;
-      if (!InsertOrUpdateAdInfo(ad_info) ||
-          !InsertOrUpdateAdInfoCategory(ad_info, category)) {
-        GetDB().RollbackTransaction();
-        return false;
-      }
+  return true;
+}
+
+bool BundleStateDatabase::UpdateAdInfos(
+    const std::map<AdInfoKey, const ads::AdInfo*>& ad_infos) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::vector<AdInfoKey> removed_ad_infos;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT region, uuid FROM ad_info"));
+  while (select_statement.Step()) {
+    AdInfoKey key(select_statement.ColumnString(0),
+        select_statement.ColumnString(1));
+    if (ad_infos.find(key) == ad_infos.end()) {
+      removed_ad_infos.push_back(key);
     }
   }
 
-  if (GetDB().CommitTransaction()) {
-    Vacuum();
-    return true;
+  if (!select_statement.Succeeded())
+    return false;
+
+  for (const auto& key : removed_ad_infos) {
+    if (!DeleteAdInfo(key.first, key.second))
+      return false;
+  }
+
+  for (const auto& ad_info : ad_infos) {
+    const std::string& region = ad_info.first.first;
+    if (HasAdInfo(*ad_info.second, region))
+      continue;
+
+    if (!InsertOrUpdateAdInfo(*ad_info.second, region))
+      return false;
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::UpdateAdInfoCategories(
+    const std::set<AdInfoCategoryKey>& ad_info_categories) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::set<AdInfoCategoryKey> saved_ad_info_categories;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT ad_info_uuid, category_name FROM ad_info_category"));
+  while (select_statement.Step()) {
+    saved_ad_info_categories.insert({select_statement.ColumnString(0),
+        select_statement.ColumnString(1)});
+  }
+
+  if (!select_statement.Succeeded())
+    return false;
+
+  for (const auto& key : saved_ad_info_categories) {
+    if (ad_info_categories.find(key) != ad_info_categories.end())
+      continue;
+
+    if (!DeleteAdInfoCategory(key.first, key.second))
+      return false;
+  }
+
+  for (const auto& key : ad_info_categories) {
+    if (saved_ad_info_categories.find(key) != saved_ad_info_categories.end())
+      continue;
+
+    if (!InsertOrUpdateAdInfoCategory(key.first, key.second))
+      return false;
   }
 
-  return false;
+  return true;
+}
+
+bool BundleStateDatabase::HasAdInfo(
+    const ads::AdInfo& info,
+    const std::string& region) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Timestamps are compared as normalized by InsertOrUpdateAdInfo()
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "SELECT 1 FROM ad_info "
+          "WHERE region = ? AND uuid = ? AND creative_set_id = ? AND "
+          "advertiser = ? AND notification_text = ? AND "
+          "notification_url = ? AND start_timestamp IS datetime(?) AND "
+          "end_timestamp IS datetime(?) AND campaign_id = ? AND "
+          "daily_cap = ? AND per_day = ? AND total_max = ?"));
+
+  ad_info_statement.BindString(0, region);
+  ad_info_statement.BindString(1, info.uuid);
+  ad_info_statement.BindString(2, info.creative_set_id);
+  ad_info_statement.BindString(3, info.advertiser);
+  ad_info_statement.BindString(4, info.notification_text);
+  ad_info_statement.BindString(5, info.notification_url);
+  ad_info_statement.BindString(6, info.start_timestamp);
+  ad_info_statement.BindString(7, info.end_timestamp);
+  ad_info_statement.BindString(8, info.campaign_id);
+  ad_info_statement.BindInt(9, info.daily_cap);
+  ad_info_statement.BindInt(10, info.per_day);
+  ad_info_statement.BindInt(11, info.total_max);
+
+  return ad_info_statement.Step();
 }
 
 bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
@@ -266,7 +424,9 @@ bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
   return ad_info_statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
+bool BundleStateDatabase::InsertOrUpdateAdInfo(
+    const ads::AdInfo& info,
+    const std::string& region) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   bool initialized = Init();
@@ -275,37 +435,37 @@ bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
   if (!initialized)
     return false;
 
-  for (auto it = info.regions.begin(); it != info.regions.end(); ++it) {
-    sql::Statement ad_info_statement(
-        GetDB().GetCachedStatement(SQL_FROM_HERE,
-            "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, advertiser, notification_text, "
-            "notification_url, start_timestamp, end_timestamp, uuid, "
-            "campaign_id, daily_cap, per_day, total_max, region) "
-            "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
-
-    ad_info_statement.BindString(0, info.creative_set_id);
-    ad_info_statement.BindString(1, info.advertiser);
-    ad_info_statement.BindString(2, info.notification_text);
-    ad_info_statement.BindString(3, info.notification_url);
-    ad_info_statement.BindString(4, info.start_timestamp);
-    ad_info_statement.BindString(5, info.end_timestamp);
-    ad_info_statement.BindString(6, info.uuid);
-    ad_info_statement.BindString(7, info.campaign_id);
-    ad_info_statement.BindInt(8, info.daily_cap);
-    ad_info_statement.BindInt(9, info.per_day);
-    ad_info_statement.BindInt(10, info.total_max);
-    ad_info_statement.BindString(11, *it);
-    if (!ad_info_statement.Run()) {
-      return false;
-    }
-  }
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "INSERT OR REPLACE INTO ad_info "
+          "(creative_set_id, advertiser, notification_text, "
+          "notification_url, start_timestamp, end_timestamp, uuid, "
+          "campaign_id, daily_cap, per_day, total_max, region, "
+          "start_timestamp_in_seconds, end_timestamp_in_seconds) "
+          "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?, "
+          "CAST(strftime('%s', ?) AS INTEGER), "
+          "CAST(strftime('%s', ?) AS INTEGER))"));
+
+  ad_info_statement.BindString(0, info.creative_set_id);
+  ad_info_statement.BindString(1, info.advertiser);
+  ad_info_statement.BindString(2, info.notification_text);
+  ad_info_statement.BindString(3, info.notification_url);
+  ad_info_statement.BindString(4, info.start_timestamp);
+  ad_info_statement.BindString(5, info.end_timestamp);
+  ad_info_statement.BindString(6, info.uuid);
+  ad_info_statement.BindString(7, info.campaign_id);
+  ad_info_statement.BindInt(8, info.daily_cap);
+  ad_info_statement.BindInt(9, info.per_day);
+  ad_info_statement.BindInt(10, info.total_max);
+  ad_info_statement.BindString(11, region);
+  ad_info_statement.BindString(12, info.start_timestamp);
+  ad_info_statement.BindString(13, info.end_timestamp);
 
-  return true;
+  return ad_info_statement.Run();
 }
 
 bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
-    const ads::AdInfo& ad_info,
+    const std::string& ad_info_uuid,
     const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -321,12 +481,52 @@ bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
           "(ad_info_uuid, category_name) "
           "VALUES (?, ?)"));
 
-  ad_info_statement.BindString(0, ad_info.uuid);
+  ad_info_statement.BindString(0, ad_info_uuid);
   ad_info_statement.BindString(1, category);
 
   return ad_info_statement.Run();
 }
 
+bool BundleStateDatabase::DeleteCategory(const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM category WHERE name = ?"));
+
+  sql.BindString(0, category);
+
+  return sql.Run();
+}
+
+bool BundleStateDatabase::DeleteAdInfo(
+    const std::string& region,
+    const std::string& uuid) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info WHERE region = ? AND uuid = ?"));
+
+  sql.BindString(0, region);
+  sql.BindString(1, uuid);
+
+  return sql.Run();
+}
+
+bool BundleStateDatabase::DeleteAdInfoCategory(
+    const std::string& ad_info_uuid,
+    const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info_category "
+      "WHERE ad_info_uuid = ? AND category_name = ?"));
+
+  sql.BindString(0, ad_info_uuid);
+  sql.BindString(1, category);
+
+  return sql.Run();
+}
+
 bool BundleStateDatabase::GetAdsForCategory(
     const std::string& category,
     std::vector<ads::AdInfo>* ads) {
@@ -339,7 +539,7 @@ bool BundleStateDatabase::GetAdsForCategory(
     return false;
 
   sql::Statement info_sql(
-      db_.GetUniqueStatement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
           "SELECT ai.creative_set_id, ai.advertiser, "
           "ai.notification_text, ai.notification_url, "
           "ai.start_timestamp, ai.end_timestamp, "
@@ -347,12 +547,14 @@ bool BundleStateDatabase::GetAdsForCategory(
           "ai.per_day, ai.total_max FROM ad_info AS ai "
           "INNER JOIN ad_info_category AS aic "
           "ON aic.ad_info_uuid = ai.uuid "
-          "WHERE aic.category_name = ? and "
-          "ai.start_timestamp <= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime')) and "
-          "ai.end_timestamp >= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime'));"));
+          "WHERE aic.category_name = ? AND "
+          "ai.start_timestamp_in_seconds <= ? AND "
+          "ai.end_timestamp_in_seconds >= ?"));
+
+  const int64_t now_in_seconds = base::Time::Now().ToTimeT();
   info_sql.BindString(0, category);
+  info_sql.BindInt64(1, now_in_seconds);
+  info_sql.BindInt64(2, now_in_seconds);
 
   while (info_sql.Step()) {
     ads::AdInfo info;
@@ -411,42 +613,63 @@ sql::MetaTable& BundleStateDatabase::GetMetaTable() {
   return meta_table_;
 }
 
+// Migrations run within the transaction begun by Init(), so that a failed
+// one doesn't roll back the tables created there
 bool BundleStateDatabase::MigrateV1toV2() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (!GetDB().BeginTransaction())
-    return false;
-
   std::string sql = "ALTER TABLE ad_info ADD campaign_id LONGVARCHAR;";
-  if (!GetDB().Execute(sql.c_str())) {
-    GetDB().RollbackTransaction();
+  if (!GetDB().Execute(sql.c_str()))
     return false;
-  }
 
   sql = "ALTER TABLE ad_info ADD daily_cap INTEGER DEFAULT 0 NOT NULL;";
-  if (!GetDB().Execute(sql.c_str())) {
-    GetDB().RollbackTransaction();
+  if (!GetDB().Execute(sql.c_str()))
     return false;
-  }
 
   sql = "ALTER TABLE ad_info ADD per_day INTEGER DEFAULT 0 NOT NULL;";
-  if (!GetDB().Execute(sql.c_str())) {
-    GetDB().RollbackTransaction();
+  if (!GetDB().Execute(sql.c_str()))
     return false;
-  }
 
   sql = "ALTER TABLE ad_info ADD total_max INTEGER DEFAULT 0 NOT NULL;";
-  if (!GetDB().Execute(sql.c_str())) {
-    GetDB().RollbackTransaction();
+  return GetDB().Execute(sql.c_str());
+}
+
+bool BundleStateDatabase::MigrateV2toV3() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::string sql =
+      "ALTER TABLE ad_info ADD start_timestamp_in_seconds INTEGER;";
+  if (!GetDB().Execute(sql.c_str()))
     return false;
-  }
 
-  if (GetDB().CommitTransaction()) {
-    Vacuum();
-    return true;
-  }
+  sql = "ALTER TABLE ad_info ADD end_timestamp_in_seconds INTEGER;";
+  if (!GetDB().Execute(sql.c_str()))
+    return false;
+
+  // Existing timestamps were normalized to UTC by datetime()
+  sql = "UPDATE ad_info SET "
+      "start_timestamp_in_seconds = "
+      "CAST(strftime('%s', start_timestamp) AS INTEGER), "
+      "end_timestamp_in_seconds = "
+      "CAST(strftime('%s', end_timestamp) AS INTEGER);";
+  if (!GetDB().Execute(sql.c_str()))
+    return false;
 
-  return false;
+  // Older versions would save ads without the new columns
+  return meta_table_.SetCompatibleVersionNumber(kCompatibleVersionNumber);
+}
+
+bool BundleStateDatabase::Migrate(int version) {
+  switch (version) {
+    case 2: {
+      return MigrateV1toV2();
+    }
+    case 3: {
+      return MigrateV2toV3();
+    }
+    default:
+      return false;
+  }
 }
 
 sql::InitStatus BundleStateDatabase::EnsureCurrentVersion() {
@@ -459,17 +682,20 @@ sql::InitStatus BundleStateDatabase::EnsureCurrentVersion() {
   }
 
   const int old_version = meta_table_.GetVersionNumber();
-  const int cur_version = GetCurrentVersion();
-
-  // Migration from version 1 to version 2
-  if (old_version == 1 && cur_version == 2) {
-    if (!MigrateV1toV2()) {
-      LOG(ERROR) << "DB: Error with MigrateV1toV2";
+  const int current_version = GetCurrentVersion();
+  const int start_version = old_version + 1;
+
+  int migrated_version = old_version;
+  for (auto i = start_version; i <= current_version; i++) {
+    if (!Migrate(i)) {
+      LOG(ERROR) << "DB: Error with MigrateV" << (i - 1) << "toV" << i;
+      break;
     }
 
-    meta_table_.SetVersionNumber(cur_version);
+    migrated_version = i;
   }
 
+  meta_table_.SetVersionNumber(migrated_version);
   return sql::INIT_OK;
 }
 
@@ -7,7 +7,11 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_STATE_DATABASE_H_
 
 #include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -59,21 +63,48 @@ class BundleStateDatabase {
   bool CreateAdInfoTable();
   bool CreateAdInfoCategoryTable();
   bool CreateAdInfoCategoryNameIndex();
+  bool CreateAdInfoTimestampIndex();
+  bool ResetAdInfoTables();
 
-  bool TruncateCategoryTable();
-  bool TruncateAdInfoTable();
-  bool TruncateAdInfoCategoryTable();
+  // (region, uuid) and (ad_info_uuid, category_name) respectively
+  using AdInfoKey = std::pair<std::string, std::string>;
+  using AdInfoCategoryKey = std::pair<std::string, std::string>;
+
+  bool IsCatalogSaved(
+      const std::string& catalog_id,
+      const uint64_t catalog_version);
+  bool SetCatalogSaved(
+      const std::string& catalog_id,
+      const uint64_t catalog_version);
+
+  bool UpdateCategories(const std::set<std::string>& categories);
+  bool UpdateAdInfos(
+      const std::map<AdInfoKey, const ads::AdInfo*>& ad_infos);
+  bool UpdateAdInfoCategories(
+      const std::set<AdInfoCategoryKey>& ad_info_categories);
+
+  bool HasAdInfo(const ads::AdInfo& info, const std::string& region);
 
   bool InsertOrUpdateCategory(const std::string& category);
-  bool InsertOrUpdateAdInfo(const ads::AdInfo& info);
+  bool InsertOrUpdateAdInfo(
+      const ads::AdInfo& info,
+      const std::string& region);
   bool InsertOrUpdateAdInfoCategory(
-      const ads::AdInfo& ad_info,
+      const std::string& ad_info_uuid,
+      const std::string& category);
+
+  bool DeleteCategory(const std::string& category);
+  bool DeleteAdInfo(const std::string& region, const std::string& uuid);
+  bool DeleteAdInfoCategory(
+      const std::string& ad_info_uuid,
       const std::string& category);
 
   sql::Database& GetDB();
   sql::MetaTable& GetMetaTable();
 
   bool MigrateV1toV2();
+  bool MigrateV2toV3();
+  bool Migrate(int version);
   sql::InitStatus EnsureCurrentVersion();
 
   sql::Database db_;
@@ -0,0 +1,246 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "sql/test/scoped_error_expecter.h"
+#include "third_party/sqlite/sqlite3.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  BundleStateDatabaseTest() {
+  }
+
+  ~BundleStateDatabaseTest() override {
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath db_file =
+        temp_dir_.GetPath().AppendASCII("BundleStateDatabaseTest.db");
+    sql::Database::Delete(db_file);
+
+    bundle_state_database_ = std::make_unique<BundleStateDatabase>(db_file);
+  }
+
+  void CreateMigrationDatabase(int start_version, base::FilePath* db_file) {
+    const std::string file_name = "bundle_state_db_v" +
+        std::to_string(start_version);
+    *db_file = temp_dir_.GetPath().AppendASCII(file_name);
+
+    // Get test data migration file
+    base::FilePath path;
+    ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &path));
+    path = path.AppendASCII("ads-data");
+    path = path.AppendASCII("migration");
+    path = path.AppendASCII(file_name);
+    ASSERT_TRUE(base::PathExists(path));
+
+    // Move it to temp dir
+    ASSERT_TRUE(base::CopyFile(path, *db_file));
+
+    bundle_state_database_ = std::make_unique<BundleStateDatabase>(*db_file);
+  }
+
+  int GetVersionNumber(const base::FilePath& db_file) {
+    bundle_state_database_.reset();
+
+    sql::Database db;
+    EXPECT_TRUE(db.Open(db_file));
+    sql::Statement statement(db.GetUniqueStatement(
+        "SELECT value FROM meta WHERE key = 'version'"));
+    if (!statement.Step())
+      return -1;
+
+    return statement.ColumnInt(0);
+  }
+
+  ads::AdInfo CreateAdInfo(const std::string& uuid) {
+    ads::AdInfo ad_info;
+    ad_info.creative_set_id = "creative_set_" + uuid;
+    ad_info.campaign_id = "campaign";
+    ad_info.start_timestamp = "2019-01-01T00:00:00Z";
+    ad_info.end_timestamp = "2099-01-01T00:00:00Z";
+    ad_info.daily_cap = 1;
+    ad_info.per_day = 2;
+    ad_info.total_max = 3;
+    ad_info.regions = {"US", "GB"};
+    ad_info.advertiser = "advertiser";
+    ad_info.notification_text = "text";
+    ad_info.notification_url = "https://brave.com";
+    ad_info.uuid = uuid;
+    return ad_info;
+  }
+
+  std::vector<std::string> GetAdUUIDsForCategory(const std::string& category) {
+    std::vector<ads::AdInfo> ads;
+    EXPECT_TRUE(bundle_state_database_->GetAdsForCategory(category, &ads));
+
+    std::vector<std::string> uuids;
+    for (const auto& ad : ads) {
+      uuids.push_back(ad.uuid + "/" + ad.notification_text);
+    }
+    std::sort(uuids.begin(), uuids.end());
+    return uuids;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BundleStateDatabase> bundle_state_database_;
+};
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_AppliesChanges) {
+  // Arrange
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "1";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] =
+      {CreateAdInfo("a"), CreateAdInfo("b")};
+  bundle_state.categories["technology-software"] = {CreateAdInfo("a")};
+  bundle_state.categories["travel"] = {CreateAdInfo("c")};
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  auto ad_info = CreateAdInfo("a");
+  ad_info.notification_text = "changed";
+  bundle_state.catalog_id = "2";
+  bundle_state.categories["technology"] = {ad_info};
+  bundle_state.categories["technology-software"] = {ad_info};
+  bundle_state.categories.erase("travel");
+
+  // Act
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  // Assert
+  // Each ad is listed once per region
+  const std::vector<std::string> expected_uuids = {"a/changed", "a/changed"};
+  EXPECT_EQ(expected_uuids, GetAdUUIDsForCategory("technology"));
+  EXPECT_EQ(expected_uuids, GetAdUUIDsForCategory("technology-software"));
+  EXPECT_TRUE(GetAdUUIDsForCategory("travel").empty());
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_SkipsSavedCatalog) {
+  // Arrange
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "1";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {CreateAdInfo("a")};
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  bundle_state.categories["technology"] = {CreateAdInfo("b")};
+
+  // Act
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  // Assert
+  const std::vector<std::string> expected_uuids = {"a/text", "a/text"};
+  EXPECT_EQ(expected_uuids, GetAdUUIDsForCategory("technology"));
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState_ResetsBundle) {
+  // Arrange
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "1";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {CreateAdInfo("a")};
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  // Act
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(ads::BundleState()));
+
+  // Assert
+  EXPECT_TRUE(GetAdUUIDsForCategory("technology").empty());
+}
+
+TEST_F(BundleStateDatabaseTest, GetAdsForCategory_ExcludesInactiveAds) {
+  // Arrange
+  auto expired_ad_info = CreateAdInfo("expired");
+  expired_ad_info.start_timestamp = "2019-01-01T00:00:00Z";
+  expired_ad_info.end_timestamp = "2019-02-01T00:00:00Z";
+
+  auto upcoming_ad_info = CreateAdInfo("upcoming");
+  upcoming_ad_info.start_timestamp = "2098-01-01T00:00:00Z";
+  upcoming_ad_info.end_timestamp = "2099-01-01T00:00:00Z";
+
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "1";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] =
+      {CreateAdInfo("a"), expired_ad_info, upcoming_ad_info};
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+
+  // Act
+  auto uuids = GetAdUUIDsForCategory("technology");
+
+  // Assert
+  const std::vector<std::string> expected_uuids = {"a/text", "a/text"};
+  EXPECT_EQ(expected_uuids, uuids);
+}
+
+TEST_F(BundleStateDatabaseTest, Migrationv2tov3) {
+  // Arrange
+  base::FilePath db_file;
+  CreateMigrationDatabase(2, &db_file);
+
+  // Act
+  auto uuids = GetAdUUIDsForCategory("technology");
+
+  // Assert
+  // The expired ad is excluded by the migrated timestamps
+  const std::vector<std::string> expected_uuids = {"a/text", "a/text"};
+  EXPECT_EQ(expected_uuids, uuids);
+  EXPECT_EQ(BundleStateDatabase::GetCurrentVersion(),
+            GetVersionNumber(db_file));
+}
+
+TEST_F(BundleStateDatabaseTest, Migrationv2tov3_ResetsAdsOnFailure) {
+  // Arrange
+  base::FilePath db_file;
+  CreateMigrationDatabase(2, &db_file);
+  {
+    // Makes adding the column fail
+    sql::Database db;
+    ASSERT_TRUE(db.Open(db_file));
+    ASSERT_TRUE(db.Execute(
+        "ALTER TABLE ad_info ADD start_timestamp_in_seconds INTEGER"));
+  }
+
+  // Act
+  sql::test::ScopedErrorExpecter expecter;
+  expecter.ExpectError(SQLITE_ERROR);
+  auto uuids = GetAdUUIDsForCategory("technology");
+  ASSERT_TRUE(expecter.SawExpectedErrors());
+
+  // Assert
+  EXPECT_TRUE(uuids.empty());
+
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "1";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {CreateAdInfo("b")};
+  ASSERT_TRUE(bundle_state_database_->SaveBundleState(bundle_state));
+  const std::vector<std::string> expected_uuids = {"b/text", "b/text"};
+  EXPECT_EQ(expected_uuids, GetAdUUIDsForCategory("technology"));
+
+  EXPECT_EQ(BundleStateDatabase::GetCurrentVersion(),
+            GetVersionNumber(db_file));
+}
+
+}  // namespace brave_ads
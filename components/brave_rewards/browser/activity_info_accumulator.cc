@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/activity_info_accumulator.h"
+
+namespace brave_rewards {
+
+ActivityInfoAccumulator::ActivityInfoAccumulator() {}
+
+ActivityInfoAccumulator::~ActivityInfoAccumulator() {}
+
+void ActivityInfoAccumulator::Add(const ledger::PublisherInfo& info) {
+  if (info.id.empty()) {
+    return;
+  }
+
+  records_[Key(info.id, info.reconcile_stamp)] = info;
+}
+
+const ledger::PublisherInfo* ActivityInfoAccumulator::Find(
+    const ledger::ActivityInfoFilter& filter) const {
+  if (filter.id.empty() ||
+      filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL ||
+      filter.percent > 0 ||
+      filter.min_duration > 0 ||
+      filter.min_visits > 0 ||
+      !filter.non_verified) {
+    return nullptr;
+  }
+
+  auto it = records_.find(Key(filter.id, filter.reconcile_stamp));
+  if (it == records_.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+bool ActivityInfoAccumulator::HasPublisher(
+    const std::string& publisher_id) const {
+  auto it = records_.lower_bound(Key(publisher_id, 0));
+  return it != records_.end() && it->first.first == publisher_id;
+}
+
+void ActivityInfoAccumulator::UpdatePublisher(
+    const ledger::PublisherInfo& info) {
+  for (auto it = records_.lower_bound(Key(info.id, 0));
+       it != records_.end() && it->first.first == info.id;
+       ++it) {
+    ledger::PublisherInfo& record = it->second;
+    record.name = info.name;
+    record.url = info.url;
+    record.provider = info.provider;
+    record.favicon_url = info.favicon_url;
+    record.verified = info.verified;
+    record.excluded = info.excluded;
+  }
+}
+
+void ActivityInfoAccumulator::MergeNormalized(
+    ledger::PublisherInfoList* list) {
+  for (auto& info : *list) {
+    auto it = records_.find(Key(info.id, info.reconcile_stamp));
+    if (it == records_.end()) {
+      continue;
+    }
+
+    ledger::PublisherInfo& record = it->second;
+    record.percent = info.percent;
+    record.weight = info.weight;
+    info.visits = record.visits;
+    info.duration = record.duration;
+    info.score = record.score;
+  }
+}
+
+ledger::PublisherInfoList ActivityInfoAccumulator::Take() {
+  ledger::PublisherInfoList list;
+  list.reserve(records_.size());
+  for (const auto& record : records_) {
+    list.push_back(record.second);
+  }
+  records_.clear();
+  return list;
+}
+
+}  // namespace brave_rewards
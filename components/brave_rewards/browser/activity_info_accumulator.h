@@ -0,0 +1,66 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_ACTIVITY_INFO_ACCUMULATOR_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_ACTIVITY_INFO_ACCUMULATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/macros.h"
+#include "bat/ledger/publisher_info.h"
+
+namespace brave_rewards {
+
+// Holds the activity saved by the ledger until it is written to the
+// database in one transaction, one record per publisher and reconcile stamp.
+// The ledger reads a record back through Find() before adding a visit to it,
+// so every record carries the visits and duration of all the visits merged
+// into it since the last write.
+class ActivityInfoAccumulator {
+ public:
+  ActivityInfoAccumulator();
+  ~ActivityInfoAccumulator();
+
+  // Replaces the record of the publisher and reconcile stamp of |info|.
+  void Add(const ledger::PublisherInfo& info);
+
+  // Returns the record |filter| asks for, or null when there is none or when
+  // |filter| has conditions only the database can check.
+  const ledger::PublisherInfo* Find(
+      const ledger::ActivityInfoFilter& filter) const;
+
+  bool HasPublisher(const std::string& publisher_id) const;
+
+  // Copies the publisher columns of |info| to the records of that publisher,
+  // so that writing them doesn't undo a publisher saved in between.
+  void UpdatePublisher(const ledger::PublisherInfo& info);
+
+  // Normalized |list| was read before the records kept: the records take its
+  // percent and weight, and it takes their visits, duration and score.
+  void MergeNormalized(ledger::PublisherInfoList* list);
+
+  // Returns the records kept and forgets them.
+  ledger::PublisherInfoList Take();
+
+  bool empty() const { return records_.empty(); }
+
+  size_t size() const { return records_.size(); }
+
+ private:
+  using Key = std::pair<std::string, uint64_t>;
+
+  std::map<Key, ledger::PublisherInfo> records_;
+
+  DISALLOW_COPY_AND_ASSIGN(ActivityInfoAccumulator);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_ACTIVITY_INFO_ACCUMULATOR_H_
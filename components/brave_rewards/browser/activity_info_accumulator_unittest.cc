@@ -0,0 +1,154 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "brave/components/brave_rewards/browser/activity_info_accumulator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ActivityInfoAccumulatorTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+ledger::PublisherInfo CreateInfo(const std::string& id,
+                                 uint64_t reconcile_stamp,
+                                 uint32_t visits,
+                                 uint64_t duration) {
+  ledger::PublisherInfo info(id);
+  info.reconcile_stamp = reconcile_stamp;
+  info.visits = visits;
+  info.duration = duration;
+  info.score = duration;
+  return info;
+}
+
+ledger::ActivityInfoFilter CreateFilter(const std::string& id,
+                                        uint64_t reconcile_stamp) {
+  ledger::ActivityInfoFilter filter;
+  filter.id = id;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter.reconcile_stamp = reconcile_stamp;
+  filter.non_verified = true;
+  return filter;
+}
+
+}  // namespace
+
+TEST(ActivityInfoAccumulatorTest, MergesVisits) {
+  ActivityInfoAccumulator accumulator;
+  EXPECT_TRUE(accumulator.empty());
+
+  // Every visit adds to the record read back.
+  accumulator.Add(CreateInfo("brave.com", 10, 1, 20));
+  for (int i = 0; i < 5; i++) {
+    const ledger::PublisherInfo* record =
+        accumulator.Find(CreateFilter("brave.com", 10));
+    ASSERT_TRUE(record);
+    ledger::PublisherInfo info = *record;
+    info.visits += 1;
+    info.duration += 20;
+    accumulator.Add(info);
+  }
+  accumulator.Add(CreateInfo("brave.com", 20, 1, 5));
+  accumulator.Add(CreateInfo("basicattentiontoken.org", 10, 1, 30));
+  accumulator.Add(CreateInfo("", 10, 1, 30));
+  EXPECT_EQ(3u, accumulator.size());
+
+  const ledger::PublisherInfo* record =
+      accumulator.Find(CreateFilter("brave.com", 10));
+  ASSERT_TRUE(record);
+  EXPECT_EQ(6u, record->visits);
+  EXPECT_EQ(120u, record->duration);
+
+  ledger::PublisherInfoList list = accumulator.Take();
+  EXPECT_TRUE(accumulator.empty());
+  ASSERT_EQ(3u, list.size());
+  EXPECT_EQ("basicattentiontoken.org", list[0].id);
+  EXPECT_EQ("brave.com", list[1].id);
+  EXPECT_EQ(10u, list[1].reconcile_stamp);
+  EXPECT_EQ(6u, list[1].visits);
+  EXPECT_EQ("brave.com", list[2].id);
+  EXPECT_EQ(20u, list[2].reconcile_stamp);
+  EXPECT_EQ(1u, list[2].visits);
+}
+
+TEST(ActivityInfoAccumulatorTest, Find) {
+  ActivityInfoAccumulator accumulator;
+  accumulator.Add(CreateInfo("brave.com", 10, 1, 20));
+
+  EXPECT_TRUE(accumulator.Find(CreateFilter("brave.com", 10)));
+  EXPECT_FALSE(accumulator.Find(CreateFilter("brave.com", 20)));
+  EXPECT_FALSE(accumulator.Find(CreateFilter("brave", 10)));
+  EXPECT_FALSE(accumulator.Find(CreateFilter("", 10)));
+
+  // Conditions are left to the database.
+  ledger::ActivityInfoFilter filter = CreateFilter("brave.com", 10);
+  filter.min_duration = 8;
+  EXPECT_FALSE(accumulator.Find(filter));
+
+  filter = CreateFilter("brave.com", 10);
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_EXCLUDED;
+  EXPECT_FALSE(accumulator.Find(filter));
+
+  filter = CreateFilter("brave.com", 10);
+  filter.non_verified = false;
+  EXPECT_FALSE(accumulator.Find(filter));
+
+  EXPECT_TRUE(accumulator.HasPublisher("brave.com"));
+  EXPECT_FALSE(accumulator.HasPublisher("brave"));
+  EXPECT_FALSE(accumulator.HasPublisher("brave.com.au"));
+}
+
+TEST(ActivityInfoAccumulatorTest, UpdatePublisher) {
+  ActivityInfoAccumulator accumulator;
+  accumulator.Add(CreateInfo("brave.com", 10, 1, 20));
+  accumulator.Add(CreateInfo("brave.com", 20, 2, 20));
+  accumulator.Add(CreateInfo("brave.com.au", 10, 3, 20));
+
+  ledger::PublisherInfo info("brave.com");
+  info.name = "Brave";
+  info.excluded = ledger::PUBLISHER_EXCLUDE::EXCLUDED;
+  accumulator.UpdatePublisher(info);
+
+  ledger::PublisherInfoList list = accumulator.Take();
+  ASSERT_EQ(3u, list.size());
+  EXPECT_EQ("Brave", list[0].name);
+  EXPECT_EQ(ledger::PUBLISHER_EXCLUDE::EXCLUDED, list[0].excluded);
+  EXPECT_EQ(1u, list[0].visits);
+  EXPECT_EQ("Brave", list[1].name);
+  EXPECT_EQ(2u, list[1].visits);
+  EXPECT_EQ("", list[2].name);
+  EXPECT_NE(ledger::PUBLISHER_EXCLUDE::EXCLUDED, list[2].excluded);
+}
+
+TEST(ActivityInfoAccumulatorTest, MergeNormalized) {
+  ActivityInfoAccumulator accumulator;
+  accumulator.Add(CreateInfo("brave.com", 10, 4, 80));
+
+  ledger::PublisherInfoList list;
+  list.push_back(CreateInfo("brave.com", 10, 3, 60));
+  list.back().percent = 75;
+  list.back().weight = 75.5;
+  list.push_back(CreateInfo("basicattentiontoken.org", 10, 1, 20));
+  list.back().percent = 25;
+  accumulator.MergeNormalized(&list);
+
+  EXPECT_EQ(4u, list[0].visits);
+  EXPECT_EQ(80u, list[0].duration);
+  EXPECT_EQ(75u, list[0].percent);
+  EXPECT_EQ(1u, list[1].visits);
+
+  const ledger::PublisherInfo* record =
+      accumulator.Find(CreateFilter("brave.com", 10));
+  ASSERT_TRUE(record);
+  EXPECT_EQ(75u, record->percent);
+  EXPECT_EQ(75.5, record->weight);
+  EXPECT_EQ(4u, record->visits);
+}
+
+}  // namespace brave_rewards
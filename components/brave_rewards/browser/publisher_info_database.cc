@@ -12,6 +12,7 @@
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
+#include "base/stl_util.h"
 #include "bat/ledger/media_publisher_info.h"
 #include "build/build_config.h"
 #include "sql/meta_table.h"
@@ -24,9 +25,127 @@ namespace brave_rewards {
 
 namespace {
 
-const int kCurrentVersionNumber = 6;
+const int kCurrentVersionNumber = 7;
 const int kCompatibleVersionNumber = 1;
 
+// Version that added activity_info_reconcile_stamp_index.
+const int kActivityInfoReconcileStampIndexVersion = 7;
+
+// Columns GetActivityList() can sort by. Others are logged and ignored, so
+// the number of cached statements stays bounded.
+const char* const kActivityListSortColumns[] = {
+  "ai.publisher_id",
+  "ai.duration",
+  "ai.visits",
+  "ai.score",
+  "ai.percent",
+  "pi.name",
+};
+
+// Identifies the statement GetActivityList() prepares for |filter|: a bit
+// per optional condition, plus the sort order.
+int GetActivityListVariant(const ledger::ActivityInfoFilter& filter) {
+  int variant = 0;
+  if (!filter.id.empty()) {
+    variant |= 1 << 0;
+  }
+  if (filter.reconcile_stamp > 0) {
+    variant |= 1 << 1;
+  }
+  if (filter.min_duration > 0) {
+    variant |= 1 << 2;
+  }
+  if (filter.excluded == ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED) {
+    variant |= 1 << 3;
+  } else if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL) {
+    variant |= 1 << 4;
+  }
+  if (filter.percent > 0) {
+    variant |= 1 << 5;
+  }
+  if (filter.min_visits > 0) {
+    variant |= 1 << 6;
+  }
+  if (!filter.non_verified) {
+    variant |= 1 << 7;
+  }
+
+  // Only one sort column was ever supported.
+  if (filter.order_by.size() > 1) {
+    LOG(WARNING) << "Activity list is only sorted by its first column";
+  }
+  if (!filter.order_by.empty()) {
+    const auto& order_by = filter.order_by.front();
+    size_t i = 0;
+    while (i < base::size(kActivityListSortColumns) &&
+           order_by.first != kActivityListSortColumns[i]) {
+      i++;
+    }
+    if (i == base::size(kActivityListSortColumns)) {
+      LOG(WARNING) << "Activity list can't be sorted by " << order_by.first;
+    } else {
+      const int sort = static_cast<int>(i + 1) << 1;
+      variant |= (sort | (order_by.second ? 1 : 0)) << 8;
+    }
+  }
+
+  return variant;
+}
+
+std::string GetActivityListQuery(int variant) {
+  std::string query = "SELECT ai.publisher_id, ai.duration, ai.score, "
+                      "ai.percent, ai.weight, pi.verified, pi.excluded, "
+                      "pi.name, pi.url, pi.provider, "
+                      "pi.favIcon, ai.reconcile_stamp, ai.visits "
+                      "FROM activity_info AS ai "
+                      "INNER JOIN publisher_info AS pi "
+                      "ON ai.publisher_id = pi.publisher_id "
+                      "WHERE 1 = 1";
+
+  if (variant & (1 << 0)) {
+    query += " AND ai.publisher_id = ?";
+  }
+
+  if (variant & (1 << 1)) {
+    query += " AND ai.reconcile_stamp = ?";
+  }
+
+  if (variant & (1 << 2)) {
+    query += " AND ai.duration >= ?";
+  }
+
+  if (variant & (1 << 3)) {
+    query += " AND pi.excluded != ?";
+  }
+
+  if (variant & (1 << 4)) {
+    query += " AND pi.excluded = ?";
+  }
+
+  if (variant & (1 << 5)) {
+    query += " AND ai.percent >= ?";
+  }
+
+  if (variant & (1 << 6)) {
+    query += " AND ai.visits >= ?";
+  }
+
+  if (variant & (1 << 7)) {
+    query += " AND pi.verified = 1";
+  }
+
+  const int sort = variant >> 8;
+  if (sort > 0) {
+    query += " ORDER BY ";
+    query += kActivityListSortColumns[(sort >> 1) - 1];
+    query += (sort & 1) ? " ASC" : " DESC";
+  }
+
+  query += " LIMIT ? OFFSET ?";
+
+  return query;
+}
+
 }  // namespace
 
 PublisherInfoDatabase::PublisherInfoDatabase(const base::FilePath& db_path) :
@@ -449,9 +568,29 @@ bool PublisherInfoDatabase::CreateActivityInfoTable() {
 bool PublisherInfoDatabase::CreateActivityInfoIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  return GetDB().Execute(
+  if (!GetDB().Execute(
       "CREATE INDEX IF NOT EXISTS activity_info_publisher_id_index "
-      "ON activity_info (publisher_id)");
+      "ON activity_info (publisher_id)")) {
+    return false;
+  }
+
+  // Older tables get it when migrating, see MigrateV6toV7().
+  if (GetTableVersionNumber() < kActivityInfoReconcileStampIndexVersion) {
+    return true;
+  }
+
+  return CreateActivityInfoReconcileStampIndex();
+}
+
+bool PublisherInfoDatabase::CreateActivityInfoReconcileStampIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Activity is always listed for one reconcile period. The other columns
+  // let the duration and visits conditions, and paging by publisher, be
+  // answered from the index.
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS activity_info_reconcile_stamp_index "
+      "ON activity_info (reconcile_stamp, publisher_id, visits, duration)");
 }
 
 bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
@@ -529,64 +668,16 @@ bool PublisherInfoDatabase::GetActivityList(
     return false;
   }
 
-  std::string query = "SELECT ai.publisher_id, ai.duration, ai.score, "
-                      "ai.percent, ai.weight, pi.verified, pi.excluded, "
-                      "pi.name, pi.url, pi.provider, "
-                      "pi.favIcon, ai.reconcile_stamp, ai.visits "
-                      "FROM activity_info AS ai "
-                      "INNER JOIN publisher_info AS pi "
-                      "ON ai.publisher_id = pi.publisher_id "
-                      "WHERE 1 = 1";
-
-  if (!filter.id.empty()) {
-    query += " AND ai.publisher_id = ?";
-  }
-
-  if (filter.reconcile_stamp > 0) {
-    query += " AND ai.reconcile_stamp = ?";
-  }
-
-  if (filter.min_duration > 0) {
-    query += " AND ai.duration >= ?";
-  }
-
-  if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL &&
-      filter.excluded !=
-        ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED) {
-    query += " AND pi.excluded = ?";
-  }
-
-  if (filter.excluded ==
-    ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED) {
-    query += " AND pi.excluded != ?";
-  }
-
-  if (filter.percent > 0) {
-    query += " AND ai.percent >= ?";
-  }
-
-  if (filter.min_visits > 0) {
-    query += " AND ai.visits >= ?";
-  }
-
-  if (!filter.non_verified) {
-    query += " AND pi.verified = 1";
-  }
-
-  for (const auto& it : filter.order_by) {
-    query += " ORDER BY " + it.first;
-    query += (it.second ? " ASC" : " DESC");
+  // Each variant is prepared once and then reused from the statement cache.
+  const int variant = GetActivityListVariant(filter);
+  std::string& statement_id = activity_list_statement_ids_[variant];
+  if (statement_id.empty()) {
+    statement_id =
+        "PublisherInfoDatabase::GetActivityList." + std::to_string(variant);
   }
-
-  if (limit > 0) {
-    query += " LIMIT " + std::to_string(limit);
-
-    if (start > 1) {
-      query += " OFFSET " + std::to_string(start);
-    }
-  }
-
-  sql::Statement info_sql(db_.GetUniqueStatement(query.c_str()));
+  sql::Statement info_sql(db_.GetCachedStatement(
+      sql::StatementID(statement_id.c_str()),
+      GetActivityListQuery(variant).c_str()));
 
   int column = 0;
   if (!filter.id.empty()) {
@@ -601,15 +692,11 @@ bool PublisherInfoDatabase::GetActivityList(
     info_sql.BindInt(column++, filter.min_duration);
   }
 
-  if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL &&
-      filter.excluded !=
-      ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED) {
-    info_sql.BindInt(column++, filter.excluded);
-  }
-
   if (filter.excluded ==
       ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED) {
     info_sql.BindInt(column++, ledger::PUBLISHER_EXCLUDE::EXCLUDED);
+  } else if (filter.excluded != ledger::EXCLUDE_FILTER::FILTER_ALL) {
+    info_sql.BindInt(column++, filter.excluded);
   }
 
   if (filter.percent > 0) {
@@ -620,6 +707,10 @@ bool PublisherInfoDatabase::GetActivityList(
     info_sql.BindInt(column++, filter.min_visits);
   }
 
+  // A negative limit is no limit.
+  info_sql.BindInt(column++, limit > 0 ? limit : -1);
+  info_sql.BindInt(column++, limit > 0 && start > 1 ? start : 0);
+
   while (info_sql.Step()) {
     std::string id(info_sql.ColumnString(0));
 
@@ -1319,6 +1410,12 @@ bool PublisherInfoDatabase::MigrateV5toV6() {
   return transaction.Commit();
 }
 
+bool PublisherInfoDatabase::MigrateV6toV7() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return CreateActivityInfoReconcileStampIndex();
+}
+
 bool PublisherInfoDatabase::Migrate(int version) {
   switch (version) {
     case 2: {
@@ -1336,6 +1433,9 @@ bool PublisherInfoDatabase::Migrate(int version) {
     case 6: {
       return MigrateV5toV6();
     }
+    case 7: {
+      return MigrateV6toV7();
+    }
     default:
       return false;
   }
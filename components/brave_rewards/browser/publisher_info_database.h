@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_PUBLISHER_INFO_DATABASE_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_PUBLISHER_INFO_DATABASE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <stddef.h>  // NOLINT
@@ -115,6 +116,8 @@ class PublisherInfoDatabase {
 
   bool CreateActivityInfoIndex();
 
+  bool CreateActivityInfoReconcileStampIndex();
+
   bool CreateMediaPublisherInfoTable();
 
   bool CreateRecurringTipsTable();
@@ -140,10 +143,16 @@ class PublisherInfoDatabase {
 
   bool MigrateV5toV6();
 
+  bool MigrateV6toV7();
+
   bool Migrate(int version);
 
   sql::InitStatus EnsureCurrentVersion();
 
+  // Names of the GetActivityList() statements by variant. A
+  // sql::StatementID only points to its name, so these must outlive the
+  // statements cached in |db_|.
+  std::map<int, std::string> activity_list_statement_ids_;
   sql::Database db_;
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
@@ -799,6 +799,45 @@ TEST_F(PublisherInfoDatabaseTest, GetActivityList) {
 
   EXPECT_EQ(list_4.at(0).id, "publisher_5");
   EXPECT_EQ(list_4.at(1).id, "publisher_6");
+
+  /**
+   * Get publishers of a reconcile period a page at a time
+  */
+  ledger::ActivityInfoFilter filter_5;
+  filter_5.reconcile_stamp = 1;
+  filter_5.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter_5.order_by.push_back(std::make_pair("ai.publisher_id", false));
+  ledger::PublisherInfoList list_5;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0,
+                                                        4,
+                                                        filter_5,
+                                                        &list_5));
+  EXPECT_EQ(static_cast<int>(list_5.size()), 4);
+  EXPECT_EQ(list_5.at(0).id, "publisher_6");
+  EXPECT_EQ(list_5.at(3).id, "publisher_3");
+
+  // The cached statement is reused with the next page's bindings.
+  list_5.clear();
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(4,
+                                                        4,
+                                                        filter_5,
+                                                        &list_5));
+  EXPECT_EQ(static_cast<int>(list_5.size()), 2);
+  EXPECT_EQ(list_5.at(0).id, "publisher_2");
+  EXPECT_EQ(list_5.at(1).id, "publisher_1");
+
+  /**
+   * Sorting by an unknown column is ignored
+  */
+  ledger::PublisherInfoList list_6;
+  ledger::ActivityInfoFilter filter_6;
+  filter_6.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter_6.order_by.push_back(std::make_pair("1; DROP TABLE x", true));
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0,
+                                                        0,
+                                                        filter_6,
+                                                        &list_6));
+  EXPECT_EQ(static_cast<int>(list_6.size()), 6);
 }
 
 
@@ -914,6 +953,28 @@ TEST_F(PublisherInfoDatabaseTest, Migrationv4tov6) {
   EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 6);
 }
 
+TEST_F(PublisherInfoDatabaseTest, Migrationv6tov7) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateMigrationDatabase(&temp_dir, &db_file, 6, 7);
+
+  ledger::PublisherInfoList list;
+  ledger::ActivityInfoFilter filter;
+  filter.reconcile_stamp = 1553423066;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter, &list));
+  EXPECT_EQ(static_cast<int>(list.size()), 3);
+
+  EXPECT_EQ(list.at(0).id, "basicattentiontoken.org");
+  EXPECT_EQ(list.at(1).id, "brave.com");
+  EXPECT_EQ(list.at(2).id, "slo-tech.com");
+
+  EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 7);
+
+  const std::string schema = publisher_info_database_->GetSchema();
+  EXPECT_EQ(schema, GetSchemaString(7));
+}
+
 TEST_F(PublisherInfoDatabaseTest, GetExcludedPublishersCount) {
   base::ScopedTempDir temp_dir;
   base::FilePath db_file;
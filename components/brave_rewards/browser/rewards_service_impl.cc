@@ -27,6 +27,7 @@
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "base/timer/timer.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/auto_contribute_props.h"
 #include "bat/ledger/media_publisher_info.h"
@@ -92,6 +93,11 @@ namespace brave_rewards {
 
 static const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Activity saved by the ledger is kept in memory and written at most this
+// often, or sooner once this many publishers have some.
+static const int kActivityInfoFlushDelaySeconds = 30;
+static const size_t kMaxPendingActivityInfo = 500;
+
 class LogStreamImpl : public ledger::LogStream {
  public:
   LogStreamImpl(const char* file,
@@ -191,6 +197,28 @@ std::string LoadStateOnFileTaskRunner(
   return data;
 }
 
+// The ledger state and the publishers list are each saved in full to one
+// file, with the changes made since appended to another.
+std::string LoadWithAppendedOnFileTaskRunner(
+    const base::FilePath& path,
+    const base::FilePath& delta_path) {
+  std::string data = LoadStateOnFileTaskRunner(path);
+  std::string delta;
+  if (!data.empty() && base::ReadFileToString(delta_path, &delta)) {
+    data.append(delta);
+  }
+  return data;
+}
+
+bool AppendToFileOnFileTaskRunner(const base::FilePath& path,
+                                  const std::string& data) {
+  const int size = static_cast<int>(data.size());
+  if (!base::PathExists(path)) {
+    return base::WriteFile(path, data.data(), size) == size;
+  }
+  return base::AppendToFile(path, data.data(), size);
+}
+
 bool SaveMediaPublisherInfoOnFileTaskRunner(
     const std::string& media_key,
     const std::string& publisher_id,
@@ -232,10 +260,10 @@ bool SavePublisherInfoOnFileTaskRunner(
   return false;
 }
 
-bool SaveActivityInfoOnFileTaskRunner(
-    const ledger::PublisherInfo publisher_info,
+bool SaveActivityInfosOnFileTaskRunner(
+    const ledger::PublisherInfoList list,
     PublisherInfoDatabase* backend) {
-  if (backend && backend->InsertOrUpdateActivityInfo(publisher_info))
+  if (backend && backend->InsertOrUpdateActivityInfos(list))
     return true;
 
   return false;
@@ -277,6 +305,20 @@ void PostWriteCallback(
                               base::Bind(callback, write_success));
 }
 
+// Runs on the file task runner straight after a ledger state snapshot is
+// written, so ahead of anything appended after it. The changes appended
+// before are part of the snapshot, but are kept if it wasn't written.
+void OnLedgerStateWritten(
+    const base::FilePath& journal_path,
+    const base::Callback<void(bool success)>& callback,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    bool write_success) {
+  if (write_success)
+    base::DeleteFile(journal_path, false);
+
+  PostWriteCallback(callback, reply_task_runner, write_success);
+}
+
 time_t GetCurrentTimestamp() {
   return base::Time::NowFromSystemTime().ToTimeT();
 }
@@ -302,6 +344,21 @@ void EnsureRewardsBaseDirectoryExists(const base::FilePath& path) {
     base::CreateDirectory(path);
 }
 
+// Owns the pipes until the ledger has answered, so that it does not depend on
+// the rewards service, which is gone by then
+void OnShutdownBatLedger(
+    bat_ledger::mojom::BatLedgerServicePtr bat_ledger_service,
+    bat_ledger::mojom::BatLedgerAssociatedPtr bat_ledger,
+    const base::FilePath& base_path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    const base::flat_map<std::string, std::string>& pending_state) {
+  for (const auto& state : pending_state) {
+    base::ImportantFileWriter writer(
+        base_path.AppendASCII(state.first), file_task_runner);
+    writer.WriteNow(std::make_unique<std::string>(state.second));
+  }
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -316,15 +373,23 @@ bool IsMediaLink(const GURL& url,
 // read comment about file pathes at src\base\files\file_path.h
 #if defined(OS_WIN)
 const base::FilePath::StringType kLedger_state(L"ledger_state");
+const base::FilePath::StringType kLedger_state_journal(
+    L"ledger_state.journal");
 const base::FilePath::StringType kPublisher_state(L"publisher_state");
 const base::FilePath::StringType kPublisher_info_db(L"publisher_info_db");
 const base::FilePath::StringType kPublishers_list(L"publishers_list");
+const base::FilePath::StringType kPublishers_list_delta(
+    L"publishers_list_delta");
 const base::FilePath::StringType kRewardsStatePath(L"rewards_service");
 #else
 const base::FilePath::StringType kLedger_state("ledger_state");
+const base::FilePath::StringType kLedger_state_journal(
+    "ledger_state.journal");
 const base::FilePath::StringType kPublisher_state("publisher_state");
 const base::FilePath::StringType kPublisher_info_db("publisher_info_db");
 const base::FilePath::StringType kPublishers_list("publishers_list");
+const base::FilePath::StringType kPublishers_list_delta(
+    "publishers_list_delta");
 const base::FilePath::StringType kRewardsStatePath("rewards_service");
 #endif
 
@@ -339,9 +404,13 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
           {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       ledger_state_path_(profile_->GetPath().Append(kLedger_state)),
+      ledger_state_journal_path_(
+          profile_->GetPath().Append(kLedger_state_journal)),
       publisher_state_path_(profile_->GetPath().Append(kPublisher_state)),
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
+      publisher_list_delta_path_(
+          profile->GetPath().Append(kPublishers_list_delta)),
       rewards_base_path_(profile_->GetPath().Append(kRewardsStatePath)),
       publisher_info_backend_(
           new PublisherInfoDatabase(publisher_info_db_path_)),
@@ -350,7 +419,11 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       private_observer_(
           std::make_unique<ExtensionRewardsServiceObserver>(profile_)),
 #endif
+      activity_info_flush_timer_(std::make_unique<base::OneShotTimer>()),
       next_timer_id_(0) {
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&RewardsServiceImpl::OnMemoryPressure,
+      base::Unretained(this))));
   file_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&EnsureRewardsBaseDirectoryExists,
                                 rewards_base_path_));
@@ -395,6 +468,21 @@ void RewardsServiceImpl::StartLedger() {
   bat_ledger_service_.set_connection_error_handler(
       base::Bind(&RewardsServiceImpl::ConnectionClosed, AsWeakPtr()));
 
+  CreateLedger(std::move(client_ptr_info));
+}
+
+void RewardsServiceImpl::StartLedgerForTesting(
+    bat_ledger::mojom::BatLedgerServicePtr bat_ledger_service) {
+  bat_ledger_client_binding_.Close();
+  bat_ledger::mojom::BatLedgerClientAssociatedPtrInfo client_ptr_info;
+  bat_ledger_client_binding_.Bind(mojo::MakeRequest(&client_ptr_info));
+
+  bat_ledger_service_ = std::move(bat_ledger_service);
+  CreateLedger(std::move(client_ptr_info));
+}
+
+void RewardsServiceImpl::CreateLedger(
+    bat_ledger::mojom::BatLedgerClientAssociatedPtrInfo client_ptr_info) {
   bool isProduction = true;
   // Environment
   #if defined(OFFICIAL_BUILD)
@@ -494,7 +582,7 @@ void RewardsServiceImpl::GetContentSiteList(
   bat_ledger_->GetActivityInfoList(
       start,
       limit,
-      filter.ToJson(),
+      filter,
       base::BindOnce(&RewardsServiceImpl::OnGetContentSiteList,
                      AsWeakPtr(),
                      callback));
@@ -502,13 +590,11 @@ void RewardsServiceImpl::GetContentSiteList(
 
 void RewardsServiceImpl::OnGetContentSiteList(
     const GetContentSiteListCallback& callback,
-    const std::vector<std::string>& json_list,
+    const ledger::PublisherInfoList& list,
     uint32_t next_record) {
   std::unique_ptr<ContentSiteList> site_list(new ContentSiteList);
 
-  for (auto &json_publisher : json_list) {
-    ledger::PublisherInfo publisher;
-    publisher.loadFromJson(json_publisher);
+  for (auto &publisher : list) {
     site_list->push_back(PublisherInfoToContentSite(publisher));
   }
 
@@ -536,7 +622,7 @@ void RewardsServiceImpl::OnLoad(SessionID tab_id, const GURL& url) {
                          publisher_url,
                          "",
                          "");
-  bat_ledger_->OnLoad(data.ToJson(), GetCurrentTimestamp());
+  bat_ledger_->OnLoad(data, GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnUnload(SessionID tab_id) {
@@ -621,7 +707,7 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                           first_party_url.spec(),
                           referrer.spec(),
                           output,
-                          visit_data.ToJson());
+                          visit_data);
 }
 
 void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
@@ -651,12 +737,18 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
                          mojo::MapToFlatMap(parts),
                          first_party_url.spec(),
                          referrer.spec(),
-                         data.ToJson());
+                         data);
 }
 
 void RewardsServiceImpl::LoadPublisherInfo(
     const std::string& publisher_key,
     ledger::PublisherInfoCallback callback) {
+  // A publisher first visited since the last flush is only saved with its
+  // activity.
+  if (pending_activity_info_.HasPublisher(publisher_key)) {
+    FlushActivityInfo();
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::Bind(&LoadPublisherInfoOnFileTaskRunner,
           publisher_key, publisher_info_backend_.get()),
@@ -684,15 +776,34 @@ void RewardsServiceImpl::LoadMediaPublisherInfo(
           media_key, publisher_info_backend_.get()),
       base::Bind(&RewardsServiceImpl::OnMediaPublisherInfoLoaded,
                      AsWeakPtr(),
+                     media_key,
+                     false,
                      callback));
 }
 
 void RewardsServiceImpl::OnMediaPublisherInfoLoaded(
+    const std::string& media_key,
+    bool flushed,
     ledger::PublisherInfoCallback callback,
     std::unique_ptr<ledger::PublisherInfo> info) {
   if (!Connected())
     return;
 
+  // The publisher of |media_key| may only be saved with its activity, which
+  // isn't known from the media key alone, so look again after writing it.
+  if (!info && !flushed && !pending_activity_info_.empty()) {
+    FlushActivityInfo();
+    base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+        base::Bind(&LoadMediaPublisherInfoOnFileTaskRunner,
+            media_key, publisher_info_backend_.get()),
+        base::Bind(&RewardsServiceImpl::OnMediaPublisherInfoLoaded,
+                       AsWeakPtr(),
+                       media_key,
+                       true,
+                       callback));
+    return;
+  }
+
   if (!info) {
     callback(ledger::Result::NOT_FOUND, nullptr);
     return;
@@ -744,6 +855,8 @@ std::string RewardsServiceImpl::GenerateGUID() const {
 }
 
 void RewardsServiceImpl::Shutdown() {
+  FlushActivityInfo();
+  memory_pressure_listener_.reset();
   RemoveObserver(notification_service_.get());
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   RemoveObserver(extension_rewards_service_observer_.get());
@@ -762,7 +875,17 @@ void RewardsServiceImpl::Shutdown() {
   }
   fetchers_.clear();
 
-  bat_ledger_.reset();
+  // The ledger answers with the confirmations state it has yet to save. The
+  // answer is handed the pipes rather than bound to |this|, which is destroyed
+  // straight after shutting down
+  if (Connected()) {
+    bat_ledger_service_.set_connection_error_handler(base::Closure());
+    bat_ledger::mojom::BatLedger* bat_ledger = bat_ledger_.get();
+    bat_ledger->Shutdown(base::BindOnce(&OnShutdownBatLedger,
+        std::move(bat_ledger_service_), std::move(bat_ledger_),
+        rewards_base_path_, file_task_runner_));
+  }
+  bat_ledger_client_binding_.Close();
   RewardsService::Shutdown();
 }
 
@@ -944,7 +1067,8 @@ void RewardsServiceImpl::OnReconcileComplete(ledger::Result result,
 void RewardsServiceImpl::LoadLedgerState(
     ledger::LedgerCallbackHandler* handler) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, ledger_state_path_),
+      base::Bind(&LoadWithAppendedOnFileTaskRunner, ledger_state_path_,
+                 ledger_state_journal_path_),
       base::Bind(&RewardsServiceImpl::OnLedgerStateLoaded,
                      AsWeakPtr(),
                      base::Unretained(handler)));
@@ -999,7 +1123,8 @@ void RewardsServiceImpl::SaveLedgerState(const std::string& ledger_state,
   writer.RegisterOnNextWriteCallbacks(
       base::Closure(),
       base::Bind(
-        &PostWriteCallback,
+        &OnLedgerStateWritten,
+        ledger_state_journal_path_,
         base::Bind(&RewardsServiceImpl::OnLedgerStateSaved, AsWeakPtr(),
             base::Unretained(handler)),
         base::SequencedTaskRunnerHandle::Get()));
@@ -1007,6 +1132,19 @@ void RewardsServiceImpl::SaveLedgerState(const std::string& ledger_state,
   writer.WriteNow(std::make_unique<std::string>(ledger_state));
 }
 
+void RewardsServiceImpl::AppendLedgerState(
+    const std::string& ledger_state,
+    ledger::LedgerCallbackHandler* handler) {
+  // Sequenced after any snapshot SaveLedgerState is writing. The changes go
+  // to a file of their own so that ledger_state stays loadable by older
+  // versions.
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::Bind(&AppendToFileOnFileTaskRunner,
+                 ledger_state_journal_path_, ledger_state),
+      base::Bind(&RewardsServiceImpl::OnLedgerStateSaved,
+                 AsWeakPtr(), base::Unretained(handler)));
+}
+
 void RewardsServiceImpl::OnLedgerStateSaved(
     ledger::LedgerCallbackHandler* handler,
     bool success) {
@@ -1061,6 +1199,7 @@ void RewardsServiceImpl::SavePublisherInfo(
     std::unique_ptr<ledger::PublisherInfo> publisher_info,
     ledger::PublisherInfoCallback callback) {
   ledger::PublisherInfo info_copy = *publisher_info;
+  pending_activity_info_.UpdatePublisher(info_copy);
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::Bind(&SavePublisherInfoOnFileTaskRunner,
                     info_copy,
@@ -1084,15 +1223,46 @@ void RewardsServiceImpl::OnPublisherInfoSaved(
 void RewardsServiceImpl::SaveActivityInfo(
     std::unique_ptr<ledger::PublisherInfo> publisher_info,
     ledger::PublisherInfoCallback callback) {
-  ledger::PublisherInfo info_copy = *publisher_info;
+  // Every visit and media heartbeat ends up here, so the activity is only
+  // written by FlushActivityInfo(). LoadActivityInfo() reads it back, which
+  // lets the next visit of the publisher add to it.
+  pending_activity_info_.Add(*publisher_info);
+  if (pending_activity_info_.size() >= kMaxPendingActivityInfo) {
+    FlushActivityInfo();
+  } else if (!activity_info_flush_timer_->IsRunning()) {
+    activity_info_flush_timer_->Start(FROM_HERE,
+        base::TimeDelta::FromSeconds(kActivityInfoFlushDelaySeconds),
+        this,
+        &RewardsServiceImpl::FlushActivityInfo);
+  }
+
+  OnActivityInfoSaved(callback, std::move(publisher_info), true);
+}
+
+void RewardsServiceImpl::FlushActivityInfo() {
+  activity_info_flush_timer_->Stop();
+  if (pending_activity_info_.empty()) {
+    return;
+  }
+
+  // Tasks posted after this one, reads included, see the activity written.
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&SaveActivityInfoOnFileTaskRunner,
-                    info_copy,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnActivityInfoSaved,
-                     AsWeakPtr(),
-                     callback,
-                     base::Passed(std::move(publisher_info))));
+      base::Bind(&SaveActivityInfosOnFileTaskRunner,
+                 pending_activity_info_.Take(),
+                 publisher_info_backend_.get()),
+      base::Bind(&RewardsServiceImpl::OnActivityInfoFlushed,
+                 AsWeakPtr()));
+}
+
+void RewardsServiceImpl::OnActivityInfoFlushed(bool success) {
+  if (!success) {
+    LOG(ERROR) << "Problem saving activity info";
+  }
+}
+
+void RewardsServiceImpl::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  FlushActivityInfo();
 }
 
 void RewardsServiceImpl::OnActivityInfoSaved(
@@ -1108,6 +1278,17 @@ void RewardsServiceImpl::OnActivityInfoSaved(
 void RewardsServiceImpl::LoadActivityInfo(
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoCallback callback) {
+  const ledger::PublisherInfo* pending = pending_activity_info_.Find(filter);
+  if (pending) {
+    callback(ledger::Result::LEDGER_OK,
+        std::make_unique<ledger::PublisherInfo>(*pending));
+    return;
+  }
+
+  if (pending_activity_info_.HasPublisher(filter.id)) {
+    FlushActivityInfo();
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::Bind(&GetActivityListOnFileTaskRunner,
           // set limit to 2 to make sure there is
@@ -1116,18 +1297,17 @@ void RewardsServiceImpl::LoadActivityInfo(
       base::Bind(&RewardsServiceImpl::OnActivityInfoLoaded,
                      AsWeakPtr(),
                      callback,
-                     filter.id));
+                     filter));
 }
 
 void RewardsServiceImpl::OnPublisherActivityInfoLoaded(
     ledger::PublisherInfoCallback callback,
     uint32_t result,
-    const std::string& info_json) {
+    const base::Optional<ledger::PublisherInfo>& info) {
   std::unique_ptr<ledger::PublisherInfo> publisher;
 
-  if (!info_json.empty()) {
-    publisher = std::make_unique<ledger::PublisherInfo>();
-    publisher->loadFromJson(info_json);
+  if (info) {
+    publisher = std::make_unique<ledger::PublisherInfo>(*info);
   }
 
   callback(static_cast<ledger::Result>(result), std::move(publisher));
@@ -1135,12 +1315,22 @@ void RewardsServiceImpl::OnPublisherActivityInfoLoaded(
 
 void RewardsServiceImpl::OnActivityInfoLoaded(
     ledger::PublisherInfoCallback callback,
-    const std::string& publisher_key,
+    const ledger::ActivityInfoFilter& filter,
     const ledger::PublisherInfoList& list) {
   if (!Connected()) {
     return;
   }
 
+  // Activity saved while reading is newer than what was read.
+  const ledger::PublisherInfo* pending = pending_activity_info_.Find(filter);
+  if (pending) {
+    callback(ledger::Result::LEDGER_OK,
+        std::make_unique<ledger::PublisherInfo>(*pending));
+    return;
+  }
+
+  const std::string& publisher_key = filter.id;
+
   // activity info not found
   if (list.size() == 0) {
     // we need to try to get at least publisher info in this case
@@ -1164,6 +1354,10 @@ void RewardsServiceImpl::OnActivityInfoLoaded(
 void RewardsServiceImpl::LoadPanelPublisherInfo(
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoCallback callback) {
+  if (pending_activity_info_.HasPublisher(filter.id)) {
+    FlushActivityInfo();
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::Bind(&GetPanelPublisherInfoOnFileTaskRunner,
                  filter,
@@ -1190,6 +1384,7 @@ void RewardsServiceImpl::GetActivityInfoList(
     uint32_t limit,
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoListCallback callback) {
+  FlushActivityInfo();
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::Bind(&GetActivityListOnFileTaskRunner,
                     start, limit, filter,
@@ -1765,6 +1960,11 @@ void RewardsServiceImpl::TriggerOnRewardsMainEnabled(
 
 void RewardsServiceImpl::SavePublishersList(const std::string& publishers_list,
                                       ledger::LedgerCallbackHandler* handler) {
+  // The deltas applied to the previous list are part of the new one.
+  file_task_runner_->PostTask(FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&base::DeleteFile),
+                     publisher_list_delta_path_, false));
+
   base::ImportantFileWriter writer(
       publisher_list_path_, file_task_runner_);
 
@@ -1779,6 +1979,16 @@ void RewardsServiceImpl::SavePublishersList(const std::string& publishers_list,
   writer.WriteNow(std::make_unique<std::string>(publishers_list));
 }
 
+void RewardsServiceImpl::AppendPublishersListDelta(
+    const std::string& publishers_list_delta,
+    ledger::LedgerCallbackHandler* handler) {
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::Bind(&AppendToFileOnFileTaskRunner,
+                 publisher_list_delta_path_, publishers_list_delta),
+      base::Bind(&RewardsServiceImpl::OnPublishersListSaved,
+                 AsWeakPtr(), base::Unretained(handler)));
+}
+
 void RewardsServiceImpl::OnPublishersListSaved(
     ledger::LedgerCallbackHandler* handler,
     bool success) {
@@ -1818,7 +2028,8 @@ void RewardsServiceImpl::OnTimer(uint32_t timer_id) {
 void RewardsServiceImpl::LoadPublisherList(
     ledger::LedgerCallbackHandler* handler) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, publisher_list_path_),
+      base::Bind(&LoadWithAppendedOnFileTaskRunner, publisher_list_path_,
+                 publisher_list_delta_path_),
       base::Bind(&RewardsServiceImpl::OnPublisherListLoaded,
           AsWeakPtr(), base::Unretained(handler)));
 }
@@ -1938,7 +2149,7 @@ void RewardsServiceImpl::GetPublisherActivityFromUrl(
   visitData.favicon_url = favicon_url;
 
   bat_ledger_->GetPublisherActivityFromUrl(
-    windowId, visitData.ToJson(), publisher_blob);
+    windowId, visitData, publisher_blob);
 }
 
 void RewardsServiceImpl::OnExcludedSitesChanged(
@@ -2143,7 +2354,7 @@ void RewardsServiceImpl::OnDonate(const std::string& publisher_key, int amount,
 
   ledger::PublisherInfo publisher(publisher_key);
 
-  bat_ledger_->DoDirectDonation(publisher.ToJson(), amount, "BAT");
+  bat_ledger_->DoDirectDonation(publisher, amount, "BAT");
 }
 
 bool SaveContributionInfoOnFileTaskRunner(
@@ -2230,13 +2441,11 @@ ledger::PublisherInfoList GetRecurringTipsOnFileTaskRunner(
 
 void RewardsServiceImpl::OnGetRecurringTipsUI(
     GetRecurringTipsCallback callback,
-    const std::vector<std::string>& json_list) {
+    const ledger::PublisherInfoList& list) {
     std::unique_ptr<brave_rewards::ContentSiteList> new_list(
       new brave_rewards::ContentSiteList);
 
-  for (auto &json_publisher : json_list) {
-    ledger::PublisherInfo publisher;
-    publisher.loadFromJson(json_publisher);
+  for (auto &publisher : list) {
     brave_rewards::ContentSite site = PublisherInfoToContentSite(publisher);
     site.percentage = publisher.weight;
     new_list->push_back(site);
@@ -2275,13 +2484,11 @@ void RewardsServiceImpl::GetRecurringTips(
 
 void RewardsServiceImpl::OnGetOneTimeTipsUI(
     GetRecurringTipsCallback callback,
-    const std::vector<std::string>& json_list) {
+    const ledger::PublisherInfoList& list) {
     std::unique_ptr<brave_rewards::ContentSiteList> new_list(
       new brave_rewards::ContentSiteList);
 
-  for (auto &json_publisher : json_list) {
-    ledger::PublisherInfo publisher;
-    publisher.loadFromJson(json_publisher);
+  for (auto &publisher : list) {
     brave_rewards::ContentSite site = PublisherInfoToContentSite(publisher);
     site.percentage = publisher.weight;
     new_list->push_back(site);
@@ -2730,6 +2937,7 @@ bool RestorePublisherOnFileTaskRunner(PublisherInfoDatabase* backend) {
 
 void RewardsServiceImpl::OnRestorePublishers(
     ledger::OnRestoreCallback callback) {
+  FlushActivityInfo();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
@@ -2778,12 +2986,16 @@ void RewardsServiceImpl::SaveNormalizedPublisherList(
     return;
   }
 
+  // Visits saved since the list was read must not be written over.
+  ledger::PublisherInfoList normalized_list = list.list;
+  pending_activity_info_.MergeNormalized(&normalized_list);
+
   base::PostTaskAndReplyWithResult(
     file_task_runner_.get(),
     FROM_HERE,
     base::Bind(&SaveNormalizedPublisherListOnFileTaskRunner,
                publisher_info_backend_.get(),
-               list.list),
+               normalized_list),
     base::Bind(&RewardsServiceImpl::OnPublisherListNormalizedSaved,
                AsWeakPtr()));
 }
@@ -2873,6 +3085,7 @@ void RewardsServiceImpl::DeleteActivityInfo(const std::string& publisher_key) {
 void RewardsServiceImpl::OnDeleteActivityInfoStamp(
     const std::string& publisher_key,
     uint64_t reconcile_stamp) {
+  FlushActivityInfo();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
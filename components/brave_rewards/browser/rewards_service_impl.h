@@ -16,10 +16,13 @@
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/wallet_info.h"
 #include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/optional.h"
 #include "base/observer_list.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
+#include "brave/components/brave_rewards/browser/activity_info_accumulator.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
 #include "content/public/browser/browser_thread.h"
@@ -83,6 +86,8 @@ class RewardsServiceImpl : public RewardsService,
 
   void Init();
   void StartLedger();
+  void CreateLedger(
+      bat_ledger::mojom::BatLedgerClientAssociatedPtrInfo client_ptr_info);
   void CreateWallet() override;
   void FetchWalletProperties() override;
   void FetchGrants(const std::string& lang,
@@ -107,7 +112,7 @@ class RewardsServiceImpl : public RewardsService,
       const GetContentSiteListCallback& callback) override;
   void OnGetContentSiteList(
       const GetContentSiteListCallback& callback,
-      const std::vector<std::string>& json_list,
+      const ledger::PublisherInfoList& list,
       uint32_t next_record);
   void OnLoad(SessionID tab_id, const GURL& url) override;
   void OnUnload(SessionID tab_id) override;
@@ -167,7 +172,7 @@ class RewardsServiceImpl : public RewardsService,
   void RemoveRecurringTip(const std::string& publisher_key) override;
   void OnGetRecurringTipsUI(
       GetRecurringTipsCallback callback,
-      const std::vector<std::string>& json_list);
+      const ledger::PublisherInfoList& list);
   void GetRecurringTipsUI(GetRecurringTipsCallback callback) override;
   void GetOneTimeTips(
       ledger::PublisherInfoListCallback callback) override;
@@ -212,6 +217,10 @@ class RewardsServiceImpl : public RewardsService,
 
   // Testing methods
   void SetLedgerEnvForTesting();
+  // Starts the ledger through |bat_ledger_service| instead of the utility
+  // process
+  void StartLedgerForTesting(
+      bat_ledger::mojom::BatLedgerServicePtr bat_ledger_service);
   void StartAutoContributeForTest();
 
  private:
@@ -245,13 +254,19 @@ class RewardsServiceImpl : public RewardsService,
                             std::unique_ptr<ledger::PublisherInfo> info,
                             bool success);
   void OnActivityInfoLoaded(ledger::PublisherInfoCallback callback,
-                            const std::string& publisher_key,
+                            const ledger::ActivityInfoFilter& filter,
                             const ledger::PublisherInfoList& list);
+  void FlushActivityInfo();
+  void OnActivityInfoFlushed(bool success);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
   void OnMediaPublisherInfoSaved(bool success);
   void OnPublisherInfoLoaded(ledger::PublisherInfoCallback callback,
                              std::unique_ptr<ledger::PublisherInfo> info);
-  void OnMediaPublisherInfoLoaded(ledger::PublisherInfoCallback callback,
-                             std::unique_ptr<ledger::PublisherInfo> info);
+  void OnMediaPublisherInfoLoaded(const std::string& media_key,
+                                  bool flushed,
+                                  ledger::PublisherInfoCallback callback,
+                                  std::unique_ptr<ledger::PublisherInfo> info);
   void OnPublisherInfoListLoaded(uint32_t start,
                                  uint32_t limit,
                                  ledger::PublisherInfoListCallback callback,
@@ -304,11 +319,12 @@ class RewardsServiceImpl : public RewardsService,
                             bool result);
 
   void OnGetOneTimeTipsUI(GetRecurringTipsCallback callback,
-                          const std::vector<std::string>& json_list);
+                          const ledger::PublisherInfoList& list);
 
-  void OnPublisherActivityInfoLoaded(ledger::PublisherInfoCallback callback,
-                                     uint32_t result,
-                                     const std::string& info_json);
+  void OnPublisherActivityInfoLoaded(
+      ledger::PublisherInfoCallback callback,
+      uint32_t result,
+      const base::Optional<ledger::PublisherInfo>& info);
 
   // ledger::LedgerClient
   std::string GenerateGUID() const override;
@@ -330,6 +346,8 @@ class RewardsServiceImpl : public RewardsService,
   void LoadPublisherState(ledger::LedgerCallbackHandler* handler) override;
   void SaveLedgerState(const std::string& ledger_state,
                        ledger::LedgerCallbackHandler* handler) override;
+  void AppendLedgerState(const std::string& ledger_state,
+                         ledger::LedgerCallbackHandler* handler) override;
   void SavePublisherState(const std::string& publisher_state,
                           ledger::LedgerCallbackHandler* handler) override;
   void SavePublisherInfo(std::unique_ptr<ledger::PublisherInfo> publisher_info,
@@ -347,6 +365,8 @@ class RewardsServiceImpl : public RewardsService,
       ledger::PublisherInfoListCallback callback) override;
   void SavePublishersList(const std::string& publishers_list,
                           ledger::LedgerCallbackHandler* handler) override;
+  void AppendPublishersListDelta(const std::string& publishers_list_delta,
+                                 ledger::LedgerCallbackHandler* handler) override;
   void SetTimer(uint64_t time_offset, uint32_t* timer_id) override;
   void LoadPublisherList(ledger::LedgerCallbackHandler* handler) override;
   void LoadURL(const std::string& url,
@@ -488,9 +508,11 @@ class RewardsServiceImpl : public RewardsService,
 #endif
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   const base::FilePath ledger_state_path_;
+  const base::FilePath ledger_state_journal_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
   const base::FilePath publisher_list_path_;
+  const base::FilePath publisher_list_delta_path_;
   const base::FilePath rewards_base_path_;
   std::unique_ptr<PublisherInfoDatabase> publisher_info_backend_;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
@@ -506,6 +528,9 @@ class RewardsServiceImpl : public RewardsService,
   std::vector<BitmapFetcherService::RequestId> request_ids_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
+  ActivityInfoAccumulator pending_activity_info_;
+  std::unique_ptr<base::OneShotTimer> activity_info_flush_timer_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   uint32_t next_timer_id_;
 
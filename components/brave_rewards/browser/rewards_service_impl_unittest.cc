@@ -4,15 +4,22 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <string>
+#include <utility>
 
+#include "base/containers/flat_map.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "brave/components/brave_rewards/browser/wallet_properties.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "brave/components/brave_rewards/browser/test_util.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom-test-utils.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/test/test_browser_thread_bundle.h"
+#include "mojo/public/cpp/bindings/associated_binding.h"
+#include "mojo/public/cpp/bindings/binding.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -56,6 +63,84 @@ class MockRewardsServiceObserver : public RewardsServiceObserver {
       void(RewardsService*, int, ledger::PublisherInfo*, uint64_t));
 };
 
+// Answers Shutdown() with |pending_state|
+class FakeBatLedger : public bat_ledger::mojom::BatLedgerInterceptorForTesting {
+ public:
+  explicit FakeBatLedger(
+      const base::flat_map<std::string, std::string>& pending_state)
+      : pending_state_(pending_state) {}
+  ~FakeBatLedger() override {}
+
+  bat_ledger::mojom::BatLedger* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void Initialize() override {}
+
+  void Shutdown(ShutdownCallback callback) override {
+    std::move(callback).Run(pending_state_);
+  }
+
+ private:
+  base::flat_map<std::string, std::string> pending_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeBatLedger);
+};
+
+class FakeBatLedgerService : public bat_ledger::mojom::BatLedgerService {
+ public:
+  explicit FakeBatLedgerService(
+      const base::flat_map<std::string, std::string>& pending_state)
+      : binding_(this),
+        bat_ledger_(pending_state),
+        bat_ledger_binding_(&bat_ledger_) {}
+  ~FakeBatLedgerService() override {}
+
+  bat_ledger::mojom::BatLedgerServicePtr Bind() {
+    bat_ledger::mojom::BatLedgerServicePtr bat_ledger_service;
+    binding_.Bind(mojo::MakeRequest(&bat_ledger_service));
+    return bat_ledger_service;
+  }
+
+  void Create(bat_ledger::mojom::BatLedgerClientAssociatedPtrInfo client_info,
+              bat_ledger::mojom::BatLedgerAssociatedRequest bat_ledger)
+      override {
+    bat_ledger_client_.Bind(std::move(client_info));
+    bat_ledger_binding_.Bind(std::move(bat_ledger));
+  }
+
+  void SetProduction(bool isProduction) override {}
+  void SetDebug(bool isDebug) override {}
+  void SetReconcileTime(int32_t time) override {}
+  void SetShortRetries(bool short_retries) override {}
+  void SetTesting() override {}
+
+  void GetProduction(GetProductionCallback callback) override {
+    std::move(callback).Run(false);
+  }
+
+  void GetDebug(GetDebugCallback callback) override {
+    std::move(callback).Run(false);
+  }
+
+  void GetReconcileTime(GetReconcileTimeCallback callback) override {
+    std::move(callback).Run(0);
+  }
+
+  void GetShortRetries(GetShortRetriesCallback callback) override {
+    std::move(callback).Run(false);
+  }
+
+ private:
+  mojo::Binding<bat_ledger::mojom::BatLedgerService> binding_;
+  FakeBatLedger bat_ledger_;
+  mojo::AssociatedBinding<bat_ledger::mojom::BatLedger> bat_ledger_binding_;
+  bat_ledger::mojom::BatLedgerClientAssociatedPtr bat_ledger_client_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeBatLedgerService);
+};
+
 class RewardsServiceTest : public testing::Test {
  public:
   RewardsServiceTest() {}
@@ -75,6 +160,12 @@ class RewardsServiceTest : public testing::Test {
   }
 
   void TearDown() override {
+    if (profile_)
+      DestroyProfile();
+  }
+
+  // Shuts down and destroys the rewards service along with the profile
+  void DestroyProfile() {
     rewards_service_->RemoveObserver(observer_.get());
     profile_.reset();
   }
@@ -82,6 +173,8 @@ class RewardsServiceTest : public testing::Test {
   Profile* profile() { return profile_.get(); }
   RewardsServiceImpl* rewards_service() { return rewards_service_; }
   MockRewardsServiceObserver* observer() { return observer_.get(); }
+  const base::FilePath& profile_path() { return temp_dir_.GetPath(); }
+  void RunUntilIdle() { thread_bundle_.RunUntilIdle(); }
 
  private:
   // Need this as a very first member to run tests in UI thread
@@ -101,6 +194,25 @@ TEST_F(RewardsServiceTest, OnWalletProperties) {
   rewards_service()->OnWalletProperties(ledger::Result::LEDGER_ERROR, nullptr);
 }
 
+TEST_F(RewardsServiceTest, SavesPendingStateWhenDestroyedAfterShutdown) {
+  // Arrange
+  const std::string state = "{\"unblinded_tokens\":[]}";
+  FakeBatLedgerService bat_ledger_service({{"confirmations.json", state}});
+  rewards_service()->StartLedgerForTesting(bat_ledger_service.Bind());
+  RunUntilIdle();
+
+  // Act
+  DestroyProfile();
+  RunUntilIdle();
+
+  // Assert
+  std::string value;
+  ASSERT_TRUE(base::ReadFileToString(profile_path()
+      .AppendASCII("rewards_service").AppendASCII("confirmations.json"),
+      &value));
+  EXPECT_EQ(state, value);
+}
+
 // add test for strange entries
 
 }  // namespace brave_rewards
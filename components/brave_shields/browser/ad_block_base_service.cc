@@ -6,11 +6,13 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -18,6 +20,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
+#include "brave/common/brave_switches.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -31,71 +34,10 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
-FilterOption ResourceTypeToFilterOption(content::ResourceType resource_type) {
-  FilterOption filter_option = FONoFilterOption;
-  switch (resource_type) {
-    // top level page
-    case content::RESOURCE_TYPE_MAIN_FRAME:
-      filter_option = FODocument;
-      break;
-    // frame or iframe
-    case content::RESOURCE_TYPE_SUB_FRAME:
-      filter_option = FOSubdocument;
-      break;
-    // a CSS stylesheet
-    case content::RESOURCE_TYPE_STYLESHEET:
-      filter_option = FOStylesheet;
-      break;
-    // an external script
-    case content::RESOURCE_TYPE_SCRIPT:
-      filter_option = FOScript;
-      break;
-    // an image (jpg/gif/png/etc)
-    case content::RESOURCE_TYPE_FAVICON:
-    case content::RESOURCE_TYPE_IMAGE:
-      filter_option = FOImage;
-      break;
-    // a font
-    case content::RESOURCE_TYPE_FONT_RESOURCE:
-      filter_option = FOFont;
-      break;
-    // an "other" subresource.
-    case content::RESOURCE_TYPE_SUB_RESOURCE:
-      filter_option = FOOther;
-      break;
-    // an object (or embed) tag for a plugin.
-    case content::RESOURCE_TYPE_OBJECT:
-      filter_option = FOObject;
-      break;
-    // a media resource.
-    case content::RESOURCE_TYPE_MEDIA:
-      filter_option = FOMedia;
-      break;
-    // a XMLHttpRequest
-    case content::RESOURCE_TYPE_XHR:
-      filter_option = FOXmlHttpRequest;
-      break;
-    // a ping request for <a ping>/sendBeacon.
-    case content::RESOURCE_TYPE_PING:
-      filter_option = FOPing;
-      break;
-    // the main resource of a dedicated
-    case content::RESOURCE_TYPE_WORKER:
-    // the main resource of a shared worker.
-    case content::RESOURCE_TYPE_SHARED_WORKER:
-    // an explicitly requested prefetch
-    case content::RESOURCE_TYPE_PREFETCH:
-    // the main resource of a service worker.
-    case content::RESOURCE_TYPE_SERVICE_WORKER:
-    // a report of Content Security Policy
-    case content::RESOURCE_TYPE_CSP_REPORT:
-    // a resource that a plugin requested.
-    case content::RESOURCE_TYPE_PLUGIN_RESOURCE:
-    case content::RESOURCE_TYPE_LAST_TYPE:
-    default:
-      break;
-  }
-  return filter_option;
+bool ShouldMemoryMapDATFiles() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  return command_line.HasSwitch(switches::kEnableAdBlockMemoryMappedDAT);
 }
 
 }  // namespace
@@ -104,7 +46,8 @@ namespace brave_shields {
 
 AdBlockBaseService::AdBlockBaseService()
     : BaseBraveShieldsService(),
-      ad_block_client_(new AdBlockClient()),
+      snapshot_(base::MakeRefCounted<AdBlockClientSnapshot>(
+          std::make_unique<AdBlockClient>(), nullptr)),
       weak_factory_(this) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
@@ -114,49 +57,68 @@ AdBlockBaseService::~AdBlockBaseService() {
 }
 
 void AdBlockBaseService::Cleanup() {
-  ad_block_client_.reset();
+  scoped_refptr<AdBlockClientSnapshot> snapshot;
+  {
+    base::AutoLock lock(snapshot_lock_);
+    snapshot.swap(snapshot_);
+  }
+  // Unmapping a memory-mapped DAT file may block, so drop the last reference
+  // on the task runner.
+  if (snapshot) {
+    GetTaskRunner()->PostTask(
+        FROM_HERE,
+        base::BindOnce([](scoped_refptr<AdBlockClientSnapshot>) {},
+                       std::move(snapshot)));
+  }
+}
+
+// static
+bool AdBlockBaseService::IsThirdPartyRequest(const GURL& url,
+    const std::string& tab_host) {
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  return !SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
+      "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES);
 }
 
 bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
     content::ResourceType resource_type, const std::string& tab_host,
     bool* did_match_exception, bool* cancel_request_explicitly) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  FilterOption current_option = ResourceTypeToFilterOption(resource_type);
-
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  if (SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
-        "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES)) {
-    current_option = static_cast<FilterOption>(
-        current_option | FONotThirdParty);
-  } else {
-    current_option = static_cast<FilterOption>(current_option | FOThirdParty);
-  }
+  return ShouldStartRequest(url.spec(), resource_type, tab_host,
+      IsThirdPartyRequest(url, tab_host), did_match_exception,
+      cancel_request_explicitly);
+}
 
-  Filter* matching_filter = nullptr;
-  Filter* matching_exception_filter = nullptr;
-  if (ad_block_client_->matches(url.spec().c_str(),
-        current_option, tab_host.c_str(), &matching_filter,
-        &matching_exception_filter)) {
-    if (matching_filter && cancel_request_explicitly &&
-        (matching_filter->filterOption & FOExplicitCancel)) {
-      *cancel_request_explicitly = true;
+bool AdBlockBaseService::ShouldStartRequest(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, bool* did_match_exception,
+    bool* cancel_request_explicitly) {
+  scoped_refptr<AdBlockClientSnapshot> snapshot = GetSnapshot();
+  if (!snapshot) {
+    if (did_match_exception) {
+      *did_match_exception = false;
     }
-    // We'd only possibly match an exception filter if we're returning true.
-    *did_match_exception = false;
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
-    return false;
+    return true;
   }
+  return snapshot->ShouldStartRequest(url_spec, resource_type, tab_host,
+      is_third_party, did_match_exception, cancel_request_explicitly);
+}
 
-  if (did_match_exception) {
-    *did_match_exception = !!matching_exception_filter;
+bool AdBlockBaseService::GetCachedDecision(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, AdBlockDecisionCache::Decision* decision) {
+  scoped_refptr<AdBlockClientSnapshot> snapshot = GetSnapshot();
+  if (!snapshot) {
+    *decision = AdBlockDecisionCache::Decision();
+    return true;
   }
+  return snapshot->GetCachedDecision(url_spec, resource_type, tab_host,
+      is_third_party, decision);
+}
 
-  return true;
+scoped_refptr<AdBlockClientSnapshot> AdBlockBaseService::GetSnapshot() {
+  base::AutoLock lock(snapshot_lock_);
+  return snapshot_;
 }
 
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
@@ -169,40 +131,90 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
 void AdBlockBaseService::EnableTagOnFileTaskRunner(
     std::string tag, bool enabled) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (enabled) {
-    ad_block_client_->addTag(tag);
-  } else {
-    ad_block_client_->removeTag(tag);
-  }
+  bool changed = enabled ? tags_.insert(tag).second : tags_.erase(tag) > 0;
+  if (!changed)
+    return;
+  // Clients built later pick the tag up from |tags_|, so only the published
+  // one needs updating.
+  scoped_refptr<AdBlockClientSnapshot> snapshot = GetSnapshot();
+  if (snapshot)
+    snapshot->EnableTag(tag, enabled);
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
-  GetTaskRunner()->PostTaskAndReply(
+  GetTaskRunner()->PostTask(
       FROM_HERE,
-      base::Bind(&brave_shields::GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&AdBlockBaseService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+      base::BindOnce(&AdBlockBaseService::LoadDATFileDataOnFileTaskRunner,
+                     base::Unretained(this), dat_file_path));
 }
 
-void AdBlockBaseService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
+void AdBlockBaseService::LoadDATFileDataOnFileTaskRunner(
+    const base::FilePath& dat_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (ShouldMemoryMapDATFiles()) {
+    std::unique_ptr<base::MemoryMappedFile> mapped_file =
+        MapDATFile(dat_file_path);
+    if (!mapped_file) {
+      LOG(ERROR) << "Could not obtain ad block data";
+      return;
+    }
+    dat_data_ = base::MakeRefCounted<AdBlockDATData>(std::move(mapped_file));
+  } else {
+    DATFileDataBuffer buffer;
+    brave_shields::GetDATFileData(dat_file_path, &buffer);
+    if (buffer.empty()) {
+      LOG(ERROR) << "Could not obtain ad block data";
+      return;
+    }
+    dat_data_ = base::MakeRefCounted<AdBlockDATData>(std::move(buffer));
   }
-  if (!ad_block_client_->deserialize(
-      reinterpret_cast<char*>(&buffer_.front()))) {
-    ad_block_client_.reset(new AdBlockClient());
+  UpdateAdBlockClient();
+}
+
+bool AdBlockBaseService::LoadAdBlockClient(AdBlockClient* client) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!dat_data_)
+    return true;
+  // Only reads the data, see AdBlockDATData::data()
+  if (!client->deserialize(const_cast<char*>(dat_data_->data()))) {
     LOG(ERROR) << "Failed to deserialize ad block data";
-    return;
+    return false;
   }
+  return true;
+}
+
+void AdBlockBaseService::UpdateAdBlockClient() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto client = std::make_unique<AdBlockClient>();
+  scoped_refptr<AdBlockDATData> data = dat_data_;
+  if (!LoadAdBlockClient(client.get())) {
+    client.reset(new AdBlockClient());
+    data = nullptr;
+  }
+  for (const auto& tag : tags_) {
+    client->addTag(tag);
+  }
+
+  auto snapshot = base::MakeRefCounted<AdBlockClientSnapshot>(
+      std::move(client), std::move(data));
+  {
+    base::AutoLock lock(snapshot_lock_);
+    snapshot_.swap(snapshot);
+  }
+  // The previous snapshot is released here unless a request is still
+  // matching against it, in which case that request releases it.
 }
 
 bool AdBlockBaseService::Init() {
   return true;
 }
 
-AdBlockClient* AdBlockBaseService::GetAdBlockClientForTest() {
-  return ad_block_client_.get();
+void AdBlockBaseService::AddRulesForTest(const std::string& rules) {
+  GetSnapshot()->AddRulesForTest(rules);
+}
+
+bool AdBlockBaseService::TagExistsForTest(const std::string& tag) {
+  return GetSnapshot()->TagExists(tag);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
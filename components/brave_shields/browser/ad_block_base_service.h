@@ -9,12 +9,16 @@
 #include <stdint.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/ad_block_client_snapshot.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
 #include "content/public/common/resource_type.h"
@@ -31,11 +35,31 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   AdBlockBaseService();
   ~AdBlockBaseService() override;
 
+  static bool IsThirdPartyRequest(const GURL& url,
+                                  const std::string& tab_host);
+
+  // Safe to call from any thread.
   bool ShouldStartRequest(const GURL &url, content::ResourceType resource_type,
     const std::string& tab_host, bool* did_match_exception,
     bool* cancel_request_explicitly) override;
+  // Same as ShouldStartRequest() but takes the URL spec and third-party state
+  // precomputed by the caller, so that a request checked against several
+  // lists only serializes the URL and classifies it once.
+  bool ShouldStartRequest(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, bool* did_match_exception,
+    bool* cancel_request_explicitly);
+  // Returns a previous ShouldStartRequest() result for the request if there
+  // is one. Never matches, so it is cheap enough to call on the IO thread.
+  bool GetCachedDecision(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, AdBlockDecisionCache::Decision* decision);
   void EnableTag(const std::string& tag, bool enabled);
 
+  // Returns the currently published client, which stays valid for as long as
+  // the caller holds on to it.
+  scoped_refptr<AdBlockClientSnapshot> GetSnapshot();
+
  protected:
   friend class ::AdBlockServiceTest;
   bool Init() override;
@@ -43,16 +67,28 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
   void EnableTagOnFileTaskRunner(std::string tag, bool enabled);
   void GetDATFileData(const base::FilePath& dat_file_path);
-  AdBlockClient* GetAdBlockClientForTest();
+  // Builds a new client from the current list data and enabled tags and
+  // publishes it. Must run on the task runner.
+  void UpdateAdBlockClient();
+  // Loads the filter list into a freshly created |client|. Returns false if
+  // the list data could not be loaded.
+  virtual bool LoadAdBlockClient(AdBlockClient* client);
+  void AddRulesForTest(const std::string& rules);
+  bool TagExistsForTest(const std::string& tag);
 
   SEQUENCE_CHECKER(sequence_checker_);
-  std::unique_ptr<AdBlockClient> ad_block_client_;
-  DATFileDataBuffer buffer_;
 
  private:
-  void OnDATFileDataReady();
+  void LoadDATFileDataOnFileTaskRunner(const base::FilePath& dat_file_path);
   void OnPreferenceChanges(const std::string& pref_name);
 
+  // Only accessed on the task runner.
+  scoped_refptr<AdBlockDATData> dat_data_;
+  std::set<std::string> tags_;
+
+  base::Lock snapshot_lock_;
+  scoped_refptr<AdBlockClientSnapshot> snapshot_;
+
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -0,0 +1,192 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_client_snapshot.h"
+
+#include <utility>
+
+#include "brave/vendor/ad-block/ad_block_client.h"
+
+namespace {
+
+FilterOption ResourceTypeToFilterOption(content::ResourceType resource_type) {
+  FilterOption filter_option = FONoFilterOption;
+  switch (resource_type) {
+    // top level page
+    case content::RESOURCE_TYPE_MAIN_FRAME:
+      filter_option = FODocument;
+      break;
+    // frame or iframe
+    case content::RESOURCE_TYPE_SUB_FRAME:
+      filter_option = FOSubdocument;
+      break;
+    // a CSS stylesheet
+    case content::RESOURCE_TYPE_STYLESHEET:
+      filter_option = FOStylesheet;
+      break;
+    // an external script
+    case content::RESOURCE_TYPE_SCRIPT:
+      filter_option = FOScript;
+      break;
+    // an image (jpg/gif/png/etc)
+    case content::RESOURCE_TYPE_FAVICON:
+    case content::RESOURCE_TYPE_IMAGE:
+      filter_option = FOImage;
+      break;
+    // a font
+    case content::RESOURCE_TYPE_FONT_RESOURCE:
+      filter_option = FOFont;
+      break;
+    // an "other" subresource.
+    case content::RESOURCE_TYPE_SUB_RESOURCE:
+      filter_option = FOOther;
+      break;
+    // an object (or embed) tag for a plugin.
+    case content::RESOURCE_TYPE_OBJECT:
+      filter_option = FOObject;
+      break;
+    // a media resource.
+    case content::RESOURCE_TYPE_MEDIA:
+      filter_option = FOMedia;
+      break;
+    // a XMLHttpRequest
+    case content::RESOURCE_TYPE_XHR:
+      filter_option = FOXmlHttpRequest;
+      break;
+    // a ping request for <a ping>/sendBeacon.
+    case content::RESOURCE_TYPE_PING:
+      filter_option = FOPing;
+      break;
+    // the main resource of a dedicated
+    case content::RESOURCE_TYPE_WORKER:
+    // the main resource of a shared worker.
+    case content::RESOURCE_TYPE_SHARED_WORKER:
+    // an explicitly requested prefetch
+    case content::RESOURCE_TYPE_PREFETCH:
+    // the main resource of a service worker.
+    case content::RESOURCE_TYPE_SERVICE_WORKER:
+    // a report of Content Security Policy
+    case content::RESOURCE_TYPE_CSP_REPORT:
+    // a resource that a plugin requested.
+    case content::RESOURCE_TYPE_PLUGIN_RESOURCE:
+    case content::RESOURCE_TYPE_LAST_TYPE:
+    default:
+      break;
+  }
+  return filter_option;
+}
+
+FilterOption GetFilterOption(content::ResourceType resource_type,
+                             bool is_third_party) {
+  // Determine third-party here so the library doesn't need to figure it out.
+  return static_cast<FilterOption>(ResourceTypeToFilterOption(resource_type) |
+      (is_third_party ? FOThirdParty : FONotThirdParty));
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+AdBlockDATData::AdBlockDATData(DATFileDataBuffer buffer)
+    : buffer_(std::move(buffer)) {
+  DCHECK(!buffer_.empty());
+}
+
+AdBlockDATData::AdBlockDATData(
+    std::unique_ptr<base::MemoryMappedFile> mapped_file)
+    : mapped_file_(std::move(mapped_file)) {
+  DCHECK(mapped_file_);
+}
+
+AdBlockDATData::~AdBlockDATData() {
+}
+
+const char* AdBlockDATData::data() const {
+  if (mapped_file_)
+    return reinterpret_cast<const char*>(mapped_file_->data());
+  return reinterpret_cast<const char*>(&buffer_.front());
+}
+
+AdBlockClientSnapshot::AdBlockClientSnapshot(
+    std::unique_ptr<AdBlockClient> client,
+    scoped_refptr<AdBlockDATData> data)
+    : client_(std::move(client)),
+      data_(std::move(data)) {
+}
+
+AdBlockClientSnapshot::~AdBlockClientSnapshot() {
+}
+
+bool AdBlockClientSnapshot::ShouldStartRequest(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, bool* did_match_exception,
+    bool* cancel_request_explicitly) {
+  FilterOption current_option = GetFilterOption(resource_type, is_third_party);
+  AdBlockDecisionCache::Decision decision;
+  if (!decision_cache_.Get(tab_host, url_spec, current_option, &decision)) {
+    base::AutoLock lock(client_lock_);
+    Filter* matching_filter = nullptr;
+    Filter* matching_exception_filter = nullptr;
+    if (client_->matches(url_spec.c_str(),
+          current_option, tab_host.c_str(), &matching_filter,
+          &matching_exception_filter)) {
+      decision.should_start_request = false;
+      decision.cancel_request_explicitly = matching_filter &&
+          (matching_filter->filterOption & FOExplicitCancel);
+      // LOG(ERROR) << "AdBlockClientSnapshot::ShouldStartRequest(), host: "
+      //  << tab_host
+      //  << ", resource type: " << resource_type
+      //  << ", url_spec: " << url_spec;
+    } else {
+      decision.did_match_exception = !!matching_exception_filter;
+    }
+    decision_cache_.Put(tab_host, url_spec, current_option, decision);
+  }
+
+  if (!decision.should_start_request) {
+    if (decision.cancel_request_explicitly && cancel_request_explicitly) {
+      *cancel_request_explicitly = true;
+    }
+    // We'd only possibly match an exception filter if we're returning true.
+    *did_match_exception = false;
+    return false;
+  }
+
+  if (did_match_exception) {
+    *did_match_exception = decision.did_match_exception;
+  }
+
+  return true;
+}
+
+bool AdBlockClientSnapshot::GetCachedDecision(const std::string& url_spec,
+    content::ResourceType resource_type, const std::string& tab_host,
+    bool is_third_party, AdBlockDecisionCache::Decision* decision) {
+  return decision_cache_.Get(tab_host, url_spec,
+      GetFilterOption(resource_type, is_third_party), decision);
+}
+
+void AdBlockClientSnapshot::EnableTag(const std::string& tag, bool enabled) {
+  base::AutoLock lock(client_lock_);
+  if (enabled) {
+    client_->addTag(tag);
+  } else {
+    client_->removeTag(tag);
+  }
+  decision_cache_.Clear();
+}
+
+bool AdBlockClientSnapshot::TagExists(const std::string& tag) {
+  base::AutoLock lock(client_lock_);
+  return client_->tagExists(tag);
+}
+
+void AdBlockClientSnapshot::AddRulesForTest(const std::string& rules) {
+  base::AutoLock lock(client_lock_);
+  client_->parse(rules.c_str());
+  decision_cache_.Clear();
+}
+
+}  // namespace brave_shields
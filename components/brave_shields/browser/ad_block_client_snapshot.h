@@ -0,0 +1,98 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CLIENT_SNAPSHOT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CLIENT_SNAPSHOT_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "content/public/common/resource_type.h"
+
+class AdBlockClient;
+
+namespace brave_shields {
+
+// The serialized bytes of an ad-block DAT file, either read into the heap or
+// memory-mapped. Deserialized clients point into them, so they are shared by
+// every snapshot built from the same file.
+class AdBlockDATData : public base::RefCountedThreadSafe<AdBlockDATData> {
+ public:
+  explicit AdBlockDATData(DATFileDataBuffer buffer);
+  explicit AdBlockDATData(std::unique_ptr<base::MemoryMappedFile> mapped_file);
+
+  // Read-only when memory-mapped. AdBlockClient::deserialize() takes a
+  // mutable pointer, but only reads the buffer and keeps pointers into it
+  // for the filters, so callers may cast away the const for it alone. The
+  // mapping faults on any write, which AdBlockClientSnapshotTest checks.
+  const char* data() const;
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockDATData>;
+  ~AdBlockDATData();
+
+  DATFileDataBuffer buffer_;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDATData);
+};
+
+// An AdBlockClient with the data it was built from and a cache of its
+// decisions. List updates publish a new snapshot, so a request keeps matching
+// against the snapshot it started with while a replacement is being built.
+// AdBlockClient::matches() updates the client's statistics counters, so
+// matching is serialized per snapshot; cache hits don't take the lock, and
+// different lists still match in parallel. Tag changes are applied to the
+// published client under the same lock, which avoids deserializing the list
+// again.
+class AdBlockClientSnapshot
+    : public base::RefCountedThreadSafe<AdBlockClientSnapshot> {
+ public:
+  AdBlockClientSnapshot(std::unique_ptr<AdBlockClient> client,
+                        scoped_refptr<AdBlockDATData> data);
+
+  bool ShouldStartRequest(const std::string& url_spec,
+                          content::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool is_third_party,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly);
+  // Looks up a previous ShouldStartRequest() result for the request without
+  // matching. Returns false if there is none.
+  bool GetCachedDecision(const std::string& url_spec,
+                         content::ResourceType resource_type,
+                         const std::string& tab_host,
+                         bool is_third_party,
+                         AdBlockDecisionCache::Decision* decision);
+
+  // Enables or disables |tag| and drops the decisions cached before.
+  void EnableTag(const std::string& tag, bool enabled);
+  bool TagExists(const std::string& tag);
+  // Adds |rules| to the client and drops the decisions cached before.
+  void AddRulesForTest(const std::string& rules);
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockClientSnapshot>;
+  ~AdBlockClientSnapshot();
+
+  // Guards |client_|. Decisions are also cached under it so that a match
+  // which raced a tag change can't cache a stale result after the clear.
+  base::Lock client_lock_;
+  std::unique_ptr<AdBlockClient> client_;
+  scoped_refptr<AdBlockDATData> data_;
+  AdBlockDecisionCache decision_cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockClientSnapshot);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CLIENT_SNAPSHOT_H_
@@ -0,0 +1,56 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_client_snapshot.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/vendor/ad-block/ad_block_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockClientSnapshotTest.*
+
+namespace brave_shields {
+
+// The mapping is read-only, so this crashes if deserializing, matching or
+// changing tags ever writes to the data.
+TEST(AdBlockClientSnapshotTest, MatchesFromReadOnlyMapping) {
+  base::FilePath path;
+  ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &path));
+  std::unique_ptr<base::MemoryMappedFile> mapped_file = MapDATFile(
+      path.AppendASCII("adblock-data").AppendASCII("adblock-default")
+          .AppendASCII("4").AppendASCII("ABPFilterParserData.dat"));
+  ASSERT_TRUE(mapped_file);
+
+  auto data = base::MakeRefCounted<AdBlockDATData>(std::move(mapped_file));
+  auto client = std::make_unique<AdBlockClient>();
+  ASSERT_TRUE(client->deserialize(const_cast<char*>(data->data())));
+  auto snapshot = base::MakeRefCounted<AdBlockClientSnapshot>(
+      std::move(client), std::move(data));
+
+  bool did_match_exception = false;
+  bool cancel_request_explicitly = false;
+  EXPECT_FALSE(snapshot->ShouldStartRequest(
+      "https://example.com/ad_banner.png", content::RESOURCE_TYPE_IMAGE,
+      "example.com", false, &did_match_exception,
+      &cancel_request_explicitly));
+  EXPECT_TRUE(snapshot->ShouldStartRequest(
+      "https://example.com/logo.png", content::RESOURCE_TYPE_IMAGE,
+      "example.com", false, &did_match_exception,
+      &cancel_request_explicitly));
+
+  snapshot->EnableTag("brave", true);
+  EXPECT_TRUE(snapshot->TagExists("brave"));
+  snapshot->EnableTag("brave", false);
+  EXPECT_FALSE(snapshot->TagExists("brave"));
+}
+
+}  // namespace brave_shields
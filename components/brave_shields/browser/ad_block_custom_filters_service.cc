@@ -53,9 +53,15 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  ad_block_client_->clear();
-  if (!custom_filters.empty())
-    ad_block_client_->parse(custom_filters.c_str());
+  custom_filters_ = custom_filters;
+  UpdateAdBlockClient();
+}
+
+bool AdBlockCustomFiltersService::LoadAdBlockClient(AdBlockClient* client) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!custom_filters_.empty())
+    client->parse(custom_filters_.c_str());
+  return true;
 }
 
 scoped_refptr<base::SequencedTaskRunner>
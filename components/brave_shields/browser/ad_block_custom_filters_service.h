@@ -28,11 +28,15 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
 
  protected:
   bool Init() override;
+  bool LoadAdBlockClient(AdBlockClient* client) override;
 
  private:
   friend class ::AdBlockServiceTest;
   void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
 
+  // Only accessed on the task runner.
+  std::string custom_filters_;
+
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
 
@@ -0,0 +1,100 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "base/strings/string_number_conversions.h"
+
+namespace brave_shields {
+
+AdBlockDecisionCache::Shard::Shard(size_t size)
+    : entries(size),
+      hits(0),
+      misses(0) {
+}
+
+AdBlockDecisionCache::Shard::~Shard() {
+}
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t size) {
+  size_t shard_size = std::max<size_t>(1, size / kShardCount);
+  for (size_t i = 0; i < kShardCount; i++) {
+    shards_.push_back(std::make_unique<Shard>(shard_size));
+  }
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() {
+}
+
+// static
+std::string AdBlockDecisionCache::MakeKey(const std::string& tab_host,
+                                          const std::string& url_spec,
+                                          int filter_option) {
+  // Neither a host nor a filter option can contain a space, so the key is
+  // unambiguous.
+  std::string key;
+  key.reserve(tab_host.size() + url_spec.size() + 12);
+  key.append(tab_host);
+  key.push_back(' ');
+  key.append(base::NumberToString(filter_option));
+  key.push_back(' ');
+  key.append(url_spec);
+  return key;
+}
+
+AdBlockDecisionCache::Shard* AdBlockDecisionCache::GetShard(
+    const std::string& key) {
+  return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+}
+
+bool AdBlockDecisionCache::Get(const std::string& tab_host,
+                               const std::string& url_spec,
+                               int filter_option,
+                               Decision* decision) {
+  const std::string key = MakeKey(tab_host, url_spec, filter_option);
+  Shard* shard = GetShard(key);
+  base::AutoLock lock(shard->lock);
+  auto it = shard->entries.Get(key);
+  if (it == shard->entries.end()) {
+    shard->misses++;
+    return false;
+  }
+  shard->hits++;
+  *decision = it->second;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const std::string& tab_host,
+                               const std::string& url_spec,
+                               int filter_option,
+                               const Decision& decision) {
+  std::string key = MakeKey(tab_host, url_spec, filter_option);
+  Shard* shard = GetShard(key);
+  base::AutoLock lock(shard->lock);
+  shard->entries.Put(std::move(key), decision);
+}
+
+void AdBlockDecisionCache::Clear() {
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    shard->entries.Clear();
+  }
+}
+
+AdBlockDecisionCache::Stats AdBlockDecisionCache::GetStats() const {
+  Stats stats;
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    stats.hits += shard->hits;
+    stats.misses += shard->misses;
+  }
+  return stats;
+}
+
+}  // namespace brave_shields
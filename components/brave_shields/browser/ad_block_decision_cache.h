@@ -0,0 +1,83 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// Bounded cache of ad-block matching results keyed by tab host, request URL
+// and filter option. Entries are spread over independently locked shards so
+// that lookups from different requests rarely contend. Each cache belongs to
+// one AdBlockClientSnapshot, so reloading a list or changing its tags starts
+// from an empty cache.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    bool should_start_request = true;
+    bool did_match_exception = false;
+    bool cancel_request_explicitly = false;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+
+  static const size_t kDefaultSize = 4096;
+  static const size_t kShardCount = 8;
+
+  explicit AdBlockDecisionCache(size_t size = kDefaultSize);
+  ~AdBlockDecisionCache();
+
+  bool Get(const std::string& tab_host,
+           const std::string& url_spec,
+           int filter_option,
+           Decision* decision);
+  void Put(const std::string& tab_host,
+           const std::string& url_spec,
+           int filter_option,
+           const Decision& decision);
+  void Clear();
+
+  // Sums the lookups counted by each shard since the cache was created.
+  Stats GetStats() const;
+
+ private:
+  struct Shard {
+    explicit Shard(size_t size);
+    ~Shard();
+
+    base::Lock lock;
+    base::HashingMRUCache<std::string, Decision> entries;
+    // Counted under |lock|, which Get() holds anyway, so that lookups on
+    // different shards don't share a counter.
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  static std::string MakeKey(const std::string& tab_host,
+                             const std::string& url_spec,
+                             int filter_option);
+  Shard* GetShard(const std::string& key);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
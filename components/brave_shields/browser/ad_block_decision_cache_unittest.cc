@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::AdBlockDecisionCache;
+
+TEST(AdBlockDecisionCacheTest, GetPutAndClear) {
+  AdBlockDecisionCache cache;
+  AdBlockDecisionCache::Decision decision;
+  ASSERT_FALSE(cache.Get("brave.com", "https://a.com/ad.js", 1, &decision));
+
+  AdBlockDecisionCache::Decision blocked;
+  blocked.should_start_request = false;
+  blocked.cancel_request_explicitly = true;
+  cache.Put("brave.com", "https://a.com/ad.js", 1, blocked);
+
+  ASSERT_TRUE(cache.Get("brave.com", "https://a.com/ad.js", 1, &decision));
+  EXPECT_FALSE(decision.should_start_request);
+  EXPECT_TRUE(decision.cancel_request_explicitly);
+
+  // Each part of the key is significant.
+  EXPECT_FALSE(cache.Get("brave.com", "https://a.com/ad.js", 2, &decision));
+  EXPECT_FALSE(cache.Get("b.brave.com", "https://a.com/ad.js", 1, &decision));
+  EXPECT_FALSE(cache.Get("brave.com", "https://a.com/ad2.js", 1, &decision));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("brave.com", "https://a.com/ad.js", 1, &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, CountsHitsAndMisses) {
+  AdBlockDecisionCache cache;
+  AdBlockDecisionCache::Decision decision;
+  ASSERT_FALSE(cache.Get("brave.com", "https://a.com/ad.js", 1, &decision));
+  EXPECT_EQ(0u, cache.GetStats().hits);
+  EXPECT_EQ(1u, cache.GetStats().misses);
+
+  // Spread over several shards.
+  for (int i = 0; i < 16; i++) {
+    cache.Put("brave.com", "https://a.com/" + std::to_string(i), 1, decision);
+  }
+  for (int i = 0; i < 16; i++) {
+    ASSERT_TRUE(cache.Get("brave.com", "https://a.com/" + std::to_string(i), 1,
+                          &decision));
+  }
+  ASSERT_FALSE(cache.Get("brave.com", "https://a.com/16", 1, &decision));
+
+  const AdBlockDecisionCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(16u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+}
+
+TEST(AdBlockDecisionCacheTest, IsBounded) {
+  AdBlockDecisionCache cache(AdBlockDecisionCache::kShardCount);
+  AdBlockDecisionCache::Decision decision;
+  for (int i = 0; i < 100; i++) {
+    cache.Put("brave.com", "https://a.com/" + std::to_string(i), 1, decision);
+  }
+  size_t found = 0;
+  for (int i = 0; i < 100; i++) {
+    if (cache.Get("brave.com", "https://a.com/" + std::to_string(i), 1,
+                  &decision)) {
+      found++;
+    }
+  }
+  EXPECT_LE(found, AdBlockDecisionCache::kShardCount);
+}
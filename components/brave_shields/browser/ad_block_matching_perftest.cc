@@ -0,0 +1,97 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_client_snapshot.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/vendor/ad-block/ad_block_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// Perf tests are disabled so that they don't slow down brave_unit_tests.
+// npm run test -- brave_unit_tests --filter=AdBlockMatchingPerfTest.*
+// --gtest_also_run_disabled_tests
+
+namespace brave_shields {
+
+class AdBlockMatchingPerfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    AddSnapshot(base::FilePath::FromUTF8Unsafe(
+        "adblock-data/adblock-default/4/ABPFilterParserData.dat"));
+    AddSnapshot(base::FilePath::FromUTF8Unsafe(
+        "adblock-data/adblock-regional/9852EFC4-99E4-4F2D-A915-9C3196C7A1DE/4/"
+        "9852EFC4-99E4-4F2D-A915-9C3196C7A1DE.dat"));
+  }
+
+  void AddSnapshot(const base::FilePath& relative_path) {
+    base::FilePath path;
+    ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &path));
+    DATFileDataBuffer buffer;
+    GetDATFileData(path.Append(relative_path), &buffer);
+    ASSERT_FALSE(buffer.empty());
+
+    auto data = base::MakeRefCounted<AdBlockDATData>(std::move(buffer));
+    auto client = std::make_unique<AdBlockClient>();
+    ASSERT_TRUE(client->deserialize(const_cast<char*>(data->data())));
+    snapshots_.push_back(base::MakeRefCounted<AdBlockClientSnapshot>(
+        std::move(client), std::move(data)));
+  }
+
+  // Every URL is distinct, so no decision is served from a cache.
+  std::vector<GURL> CreateURLs(const int count) {
+    std::vector<GURL> urls;
+    for (int i = 0; i < count; i++) {
+      urls.push_back(GURL("https://cdn" + std::to_string(i) +
+                          ".example.net/assets/banner" + std::to_string(i) +
+                          ".js?ad_slot=" + std::to_string(i)));
+    }
+    return urls;
+  }
+
+  std::vector<scoped_refptr<AdBlockClientSnapshot>> snapshots_;
+};
+
+// Splits the time spent on a request checked against every list into the
+// work shared between lists and the matching done by each list, which is
+// what a single matcher over all lists could save at most.
+TEST_F(AdBlockMatchingPerfTest, DISABLED_SharedWorkAndPerListMatching) {
+  const std::string tab_host = "www.example.com";
+  const std::vector<GURL> urls = CreateURLs(10000);
+
+  base::ElapsedTimer shared_timer;
+  std::vector<std::pair<std::string, bool>> requests;
+  for (const auto& url : urls) {
+    requests.push_back(std::make_pair(
+        url.spec(), AdBlockBaseService::IsThirdPartyRequest(url, tab_host)));
+  }
+  LOG(INFO) << "Shared work for " << urls.size() << " requests took "
+            << shared_timer.Elapsed().InMicroseconds() << " us";
+
+  for (size_t i = 0; i < snapshots_.size(); i++) {
+    base::ElapsedTimer match_timer;
+    for (const auto& request : requests) {
+      bool did_match_exception = false;
+      bool cancel_request_explicitly = false;
+      snapshots_[i]->ShouldStartRequest(request.first,
+          content::RESOURCE_TYPE_SCRIPT, tab_host, request.second,
+          &did_match_exception, &cancel_request_explicitly);
+    }
+    LOG(INFO) << "Matching " << urls.size() << " requests against list " << i
+              << " took " << match_timer.Elapsed().InMicroseconds() << " us";
+  }
+}
+
+}  // namespace brave_shields
@@ -9,10 +9,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/ad_block_client_snapshot.h"
 #include "content/public/common/resource_type.h"
 #include "url/gurl.h"
 
@@ -44,6 +46,20 @@ class AdBlockRegionalServiceManager {
                           const std::string& tab_host,
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly);
+  bool ShouldStartRequest(const std::string& url_spec,
+                          content::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool is_third_party,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly);
+  // Combines the cached decisions of every regional list the same way
+  // ShouldStartRequest() combines their matches. Returns false if any list
+  // that would be consulted has no cached decision.
+  bool GetCachedDecision(const std::string& url_spec,
+                         content::ResourceType resource_type,
+                         const std::string& tab_host,
+                         bool is_third_party,
+                         AdBlockDecisionCache::Decision* decision);
   void EnableTag(const std::string& tag, bool enabled);
   void EnableFilterList(const std::string& uuid, bool enabled);
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
@@ -51,6 +67,7 @@ class AdBlockRegionalServiceManager {
  private:
   friend class ::AdBlockServiceTest;
   bool Init();
+  std::vector<scoped_refptr<AdBlockClientSnapshot>> GetSnapshots();
   void StartRegionalServices();
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
 
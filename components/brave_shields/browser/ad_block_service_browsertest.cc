@@ -83,22 +83,19 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   }
 
   void AddRulesToAdBlock(const char* rules) {
-    g_brave_browser_process->ad_block_service()
-        ->GetAdBlockClientForTest()
-        ->parse(rules);
+    g_brave_browser_process->ad_block_service()->AddRulesForTest(rules);
   }
 
   void AssertTagExists(const std::string& tag, bool expected_exists) const {
-    bool exists_default = g_brave_browser_process->ad_block_service()
-                              ->GetAdBlockClientForTest()
-                              ->tagExists(tag);
+    bool exists_default =
+        g_brave_browser_process->ad_block_service()->TagExistsForTest(tag);
     ASSERT_EQ(exists_default, expected_exists);
 
     for (const auto& regional_service :
          g_brave_browser_process->ad_block_regional_service_manager()
              ->regional_services_) {
       bool exists_regional =
-          regional_service.second->GetAdBlockClientForTest()->tagExists(tag);
+          regional_service.second->TagExistsForTest(tag);
       ASSERT_EQ(exists_regional, expected_exists);
     }
   }
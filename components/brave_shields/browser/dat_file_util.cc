@@ -9,6 +9,7 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_shields {
 
@@ -33,6 +34,17 @@ void GetDATFileData(const base::FilePath& file_path,
   }
 }
 
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(file_path) || 0 == mapped_file->length()) {
+    LOG(ERROR) << "MapDATFile: cannot "
+               << "map dat file " << file_path;
+    return nullptr;
+  }
+  return mapped_file;
+}
+
 void GetDATFileAsString(const base::FilePath& file_path,
                         std::string* contents) {
   bool success = base::ReadFileToString(file_path, contents);
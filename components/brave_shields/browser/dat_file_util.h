@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,7 @@
 
 namespace base {
 class FilePath;
+class MemoryMappedFile;
 }
 
 namespace brave_shields {
@@ -21,6 +23,10 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
+// Maps |file_path| read-only. Returns nullptr if the file is missing, empty
+// or cannot be mapped.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
 void GetDATFileAsString(const base::FilePath& file_path,
                         std::string* contents);
 
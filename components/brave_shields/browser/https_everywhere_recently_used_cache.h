@@ -11,16 +11,16 @@
 #include "base/containers/mru_cache.h"
 #include "base/synchronization/lock.h"
 
-template <class T> class HTTPSERecentlyUsedCache {
+template <class T, class Key = std::string> class HTTPSERecentlyUsedCache {
  public:
   explicit HTTPSERecentlyUsedCache(size_t size = 100) : data_(size) {}
 
-  void add(const std::string& key, const T& value) {
+  void add(const Key& key, const T& value) {
     base::AutoLock create(lock_);
     data_.Put(key, value);
   }
 
-  bool get(const std::string& key, T* value) {
+  bool get(const Key& key, T* value) {
     base::AutoLock create(lock_);
     auto it = data_.Get(key);
     if (it != data_.end()) {
@@ -30,15 +30,20 @@ template <class T> class HTTPSERecentlyUsedCache {
     return false;
   }
 
-  void remove(const std::string& key) {
+  void remove(const Key& key) {
     base::AutoLock lock(lock_);
     auto it = data_.Peek(key);
     if (it != data_.end())
       data_.Erase(it);
   }
 
+  void clear() {
+    base::AutoLock lock(lock_);
+    data_.Clear();
+  }
+
  private:
-  base::MRUCache<std::string, T> data_;
+  base::MRUCache<Key, T> data_;
   base::Lock lock_;
 };
 
@@ -0,0 +1,90 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_tracker.h"
+
+#include <functional>
+
+#include "base/time/tick_clock.h"
+
+namespace brave_shields {
+
+HTTPSERedirectTracker::HTTPSERedirectTracker(unsigned int max_redirects,
+                                             base::TimeDelta ttl,
+                                             const base::TickClock* clock)
+    : max_redirects_(max_redirects),
+      ttl_(ttl),
+      clock_(clock) {
+  for (auto& count : filter_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+HTTPSERedirectTracker::~HTTPSERedirectTracker() {
+}
+
+// static
+size_t HTTPSERedirectTracker::GetFilterIndex(uint64_t request_identifier) {
+  return std::hash<uint64_t>()(request_identifier) % kFilterSize;
+}
+
+bool HTTPSERedirectTracker::ShouldRedirect(uint64_t request_identifier) {
+  if (filter_[GetFilterIndex(request_identifier)].load(
+          std::memory_order_acquire) == 0) {
+    return true;
+  }
+
+  base::AutoLock lock(lock_);
+  auto it = entries_.find(request_identifier);
+  if (it == entries_.end() ||
+      clock_->NowTicks() - it->second.last_redirect >= ttl_) {
+    return true;
+  }
+  return it->second.redirects < max_redirects_ - 1;
+}
+
+void HTTPSERedirectTracker::AddRedirect(uint64_t request_identifier) {
+  const base::TimeTicks now = clock_->NowTicks();
+  base::AutoLock lock(lock_);
+  RemoveExpiredEntries(now);
+
+  auto result = entries_.emplace(request_identifier, Entry());
+  if (result.second) {
+    filter_[GetFilterIndex(request_identifier)].fetch_add(
+        1, std::memory_order_release);
+  }
+  Entry& entry = result.first->second;
+  if (now - entry.last_redirect >= ttl_) {
+    entry.redirects = 0;
+  }
+  entry.redirects++;
+  entry.last_redirect = now;
+}
+
+void HTTPSERedirectTracker::RemoveExpiredEntries(base::TimeTicks now) {
+  // Sweeping at most once per |ttl_| keeps the cost amortized O(1) per
+  // redirect while bounding the map to the redirects of two TTL periods.
+  if (now < next_expiry_check_) {
+    return;
+  }
+  next_expiry_check_ = now + ttl_;
+
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (now - it->second.last_redirect >= ttl_) {
+      filter_[GetFilterIndex(it->first)].fetch_sub(
+          1, std::memory_order_release);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t HTTPSERedirectTracker::size_for_testing() {
+  base::AutoLock lock(lock_);
+  return entries_.size();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_TRACKER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_TRACKER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace base {
+class TickClock;
+}
+
+namespace brave_shields {
+
+// Counts the HTTPS Everywhere redirects issued for each in-flight request so
+// that rulesets redirecting back to http can't loop forever. Entries expire
+// |ttl| after their last redirect.
+//
+// Most requests are never redirected, so ShouldRedirect first checks a table
+// of atomic counters indexed by a hash of the request identifier and only
+// takes the lock when the identifier may have been seen.
+class HTTPSERedirectTracker {
+ public:
+  static const size_t kFilterSize = 1024;
+
+  HTTPSERedirectTracker(unsigned int max_redirects,
+                        base::TimeDelta ttl,
+                        const base::TickClock* clock);
+  ~HTTPSERedirectTracker();
+
+  bool ShouldRedirect(uint64_t request_identifier);
+  void AddRedirect(uint64_t request_identifier);
+
+  size_t size_for_testing();
+
+ private:
+  struct Entry {
+    unsigned int redirects = 0;
+    base::TimeTicks last_redirect;
+  };
+
+  static size_t GetFilterIndex(uint64_t request_identifier);
+  void RemoveExpiredEntries(base::TimeTicks now);
+
+  const unsigned int max_redirects_;
+  const base::TimeDelta ttl_;
+  const base::TickClock* clock_;
+
+  // Number of tracked identifiers hashing to each index. Only written with
+  // |lock_| held.
+  std::atomic<uint32_t> filter_[kFilterSize];
+
+  base::Lock lock_;
+  std::unordered_map<uint64_t, Entry> entries_;
+  base::TimeTicks next_expiry_check_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERedirectTracker);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_TRACKER_H_
@@ -0,0 +1,67 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_tracker.h"
+
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERedirectTracker;
+
+class HTTPSERedirectTrackerTest : public testing::Test {
+ public:
+  HTTPSERedirectTrackerTest()
+      : tracker_(5, base::TimeDelta::FromSeconds(30), &clock_) {
+    clock_.Advance(base::TimeDelta::FromMinutes(1));
+  }
+
+ protected:
+  base::SimpleTestTickClock clock_;
+  HTTPSERedirectTracker tracker_;
+};
+
+TEST_F(HTTPSERedirectTrackerTest, StopsAfterMaxRedirects) {
+  EXPECT_TRUE(tracker_.ShouldRedirect(1));
+  for (int i = 0; i < 3; i++) {
+    tracker_.AddRedirect(1);
+    EXPECT_TRUE(tracker_.ShouldRedirect(1));
+  }
+  tracker_.AddRedirect(1);
+  EXPECT_FALSE(tracker_.ShouldRedirect(1));
+}
+
+TEST_F(HTTPSERedirectTrackerTest, TracksRequestsIndependently) {
+  // With a single slot queue, interleaved requests used to evict each other
+  // and never hit the limit.
+  for (int i = 0; i < 4; i++) {
+    for (uint64_t id = 1; id <= 100; id++) {
+      tracker_.AddRedirect(id);
+    }
+  }
+  for (uint64_t id = 1; id <= 100; id++) {
+    EXPECT_FALSE(tracker_.ShouldRedirect(id));
+  }
+  EXPECT_TRUE(tracker_.ShouldRedirect(101));
+}
+
+TEST_F(HTTPSERedirectTrackerTest, EntriesExpire) {
+  for (int i = 0; i < 4; i++) {
+    tracker_.AddRedirect(1);
+  }
+  EXPECT_FALSE(tracker_.ShouldRedirect(1));
+
+  clock_.Advance(base::TimeDelta::FromSeconds(30));
+  EXPECT_TRUE(tracker_.ShouldRedirect(1));
+
+  // An expired entry starts counting from zero again.
+  tracker_.AddRedirect(1);
+  EXPECT_TRUE(tracker_.ShouldRedirect(1));
+
+  // Expired entries are removed by later redirects.
+  clock_.Advance(base::TimeDelta::FromSeconds(30));
+  tracker_.AddRedirect(2);
+  EXPECT_EQ(tracker_.size_for_testing(), 1u);
+}
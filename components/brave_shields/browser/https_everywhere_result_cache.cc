@@ -0,0 +1,82 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_result_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace brave_shields {
+
+HTTPSEverywhereResultCache::Shard::Shard(size_t size)
+    : entries(size),
+      hits(0),
+      negative_hits(0),
+      misses(0) {
+}
+
+HTTPSEverywhereResultCache::Shard::~Shard() {
+}
+
+HTTPSEverywhereResultCache::HTTPSEverywhereResultCache(size_t size)
+    : size_(std::max<size_t>(kShardCount, size)) {
+  for (size_t i = 0; i < kShardCount; i++) {
+    shards_.push_back(std::make_unique<Shard>(size_ / kShardCount));
+  }
+}
+
+HTTPSEverywhereResultCache::~HTTPSEverywhereResultCache() {
+}
+
+HTTPSEverywhereResultCache::Shard* HTTPSEverywhereResultCache::GetShard(
+    const std::string& url_spec) {
+  return shards_[std::hash<std::string>()(url_spec) % shards_.size()].get();
+}
+
+bool HTTPSEverywhereResultCache::Get(const std::string& url_spec,
+                                     std::string* new_url) {
+  Shard* shard = GetShard(url_spec);
+  base::AutoLock lock(shard->lock);
+  auto it = shard->entries.Get(url_spec);
+  if (it == shard->entries.end()) {
+    shard->misses++;
+    return false;
+  }
+  if (it->second.empty()) {
+    shard->negative_hits++;
+  } else {
+    shard->hits++;
+  }
+  *new_url = it->second;
+  return true;
+}
+
+void HTTPSEverywhereResultCache::Put(const std::string& url_spec,
+                                     const std::string& new_url) {
+  Shard* shard = GetShard(url_spec);
+  base::AutoLock lock(shard->lock);
+  shard->entries.Put(url_spec, new_url);
+}
+
+void HTTPSEverywhereResultCache::Clear() {
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    shard->entries.Clear();
+  }
+}
+
+HTTPSEverywhereResultCache::Stats HTTPSEverywhereResultCache::GetStats()
+    const {
+  Stats stats;
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    stats.hits += shard->hits;
+    stats.negative_hits += shard->negative_hits;
+    stats.misses += shard->misses;
+  }
+  return stats;
+}
+
+}  // namespace brave_shields
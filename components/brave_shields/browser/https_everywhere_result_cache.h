@@ -0,0 +1,76 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RESULT_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RESULT_CACHE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// Bounded cache of HTTPS Everywhere lookups keyed by request URL. URLs that
+// no ruleset upgrades are cached too, as an empty upgraded URL, so that the
+// IO thread can answer them without a hop to the service task runner.
+// Entries are spread over independently locked shards so that lookups from
+// the IO thread and the task runner rarely contend.
+class HTTPSEverywhereResultCache {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    // Hits on URLs that are known not to be upgradable.
+    uint64_t negative_hits = 0;
+    uint64_t misses = 0;
+  };
+
+  static const size_t kDefaultSize = 4096;
+  static const size_t kShardCount = 8;
+
+  explicit HTTPSEverywhereResultCache(size_t size = kDefaultSize);
+  ~HTTPSEverywhereResultCache();
+
+  // Returns true if |url_spec| is cached. |new_url| is left empty when the
+  // URL is known not to be upgradable.
+  bool Get(const std::string& url_spec, std::string* new_url);
+  void Put(const std::string& url_spec, const std::string& new_url);
+  void Clear();
+
+  size_t size() const { return size_; }
+
+  // Sums the lookups counted by each shard since the cache was created.
+  Stats GetStats() const;
+
+ private:
+  struct Shard {
+    explicit Shard(size_t size);
+    ~Shard();
+
+    base::Lock lock;
+    base::HashingMRUCache<std::string, std::string> entries;
+    // Counted under |lock|, which Get() holds anyway, so that lookups on
+    // different shards don't share a counter.
+    uint64_t hits;
+    uint64_t negative_hits;
+    uint64_t misses;
+  };
+
+  Shard* GetShard(const std::string& url_spec);
+
+  const size_t size_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereResultCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RESULT_CACHE_H_
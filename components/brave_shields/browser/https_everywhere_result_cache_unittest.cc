@@ -0,0 +1,77 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_result_cache.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSEverywhereResultCache;
+
+TEST(HTTPSEverywhereResultCacheTest, PositiveAndNegativeEntries) {
+  HTTPSEverywhereResultCache cache;
+  std::string new_url = "unchanged";
+  ASSERT_FALSE(cache.Get("http://a.com/", &new_url));
+  EXPECT_EQ(new_url, "unchanged");
+
+  cache.Put("http://a.com/", "https://a.com/");
+  cache.Put("http://b.com/", "");
+
+  ASSERT_TRUE(cache.Get("http://a.com/", &new_url));
+  EXPECT_EQ(new_url, "https://a.com/");
+
+  ASSERT_TRUE(cache.Get("http://b.com/", &new_url));
+  EXPECT_TRUE(new_url.empty());
+
+  // A later lookup can turn a negative entry into a positive one.
+  cache.Put("http://b.com/", "https://b.com/");
+  ASSERT_TRUE(cache.Get("http://b.com/", &new_url));
+  EXPECT_EQ(new_url, "https://b.com/");
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("http://a.com/", &new_url));
+  EXPECT_FALSE(cache.Get("http://b.com/", &new_url));
+}
+
+TEST(HTTPSEverywhereResultCacheTest, CountsLookups) {
+  HTTPSEverywhereResultCache cache;
+  std::string new_url;
+  ASSERT_FALSE(cache.Get("http://a.com/", &new_url));
+
+  // Spread over several shards.
+  for (int i = 0; i < 16; i++) {
+    cache.Put("http://" + base::NumberToString(i) + ".com/",
+              i % 2 ? "https://" + base::NumberToString(i) + ".com/" : "");
+  }
+  for (int i = 0; i < 16; i++) {
+    ASSERT_TRUE(
+        cache.Get("http://" + base::NumberToString(i) + ".com/", &new_url));
+  }
+
+  const HTTPSEverywhereResultCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(8u, stats.hits);
+  EXPECT_EQ(8u, stats.negative_hits);
+  EXPECT_EQ(1u, stats.misses);
+}
+
+TEST(HTTPSEverywhereResultCacheTest, IsBounded) {
+  HTTPSEverywhereResultCache cache(1);
+  EXPECT_EQ(cache.size(), HTTPSEverywhereResultCache::kShardCount);
+
+  for (int i = 0; i < 100; i++) {
+    cache.Put("http://" + base::NumberToString(i) + ".com/", "");
+  }
+  size_t cached = 0;
+  std::string new_url;
+  for (int i = 0; i < 100; i++) {
+    if (cache.Get("http://" + base::NumberToString(i) + ".com/", &new_url)) {
+      cached++;
+    }
+  }
+  EXPECT_LE(cached, cache.size());
+  EXPECT_GT(cached, 0u);
+}
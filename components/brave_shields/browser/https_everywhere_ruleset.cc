@@ -0,0 +1,150 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace {
+
+// Returns nullptr for patterns RE2 cannot compile, which never matched
+// anything when they were compiled on every lookup either.
+std::unique_ptr<re2::RE2> CompilePattern(const std::string& pattern) {
+  auto regexp = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  if (!regexp->ok()) {
+    return nullptr;
+  }
+  return regexp;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+HTTPSERuleset::Rule::Rule() : default_upgrade(false) {}
+
+HTTPSERuleset::Rule::Rule(Rule&& other) = default;
+
+HTTPSERuleset::Rule::~Rule() {}
+
+HTTPSERuleset::Target::Target() : has_rules(false) {}
+
+HTTPSERuleset::Target::Target(Target&& other) = default;
+
+HTTPSERuleset::Target::~Target() {}
+
+HTTPSERuleset::HTTPSERuleset() {}
+
+HTTPSERuleset::~HTTPSERuleset() {}
+
+// static
+scoped_refptr<HTTPSERuleset> HTTPSERuleset::Parse(const std::string& json) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (base::nullopt == json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  scoped_refptr<HTTPSERuleset> ruleset(new HTTPSERuleset());
+  for (const base::Value& top_value : json_object->GetList()) {
+    if (!top_value.is_dict()) {
+      continue;
+    }
+
+    Target target;
+    const base::Value* exclusions = top_value.FindKey("e");
+    if (exclusions && exclusions->is_list()) {
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict()) {
+          continue;
+        }
+        const base::Value* pattern = exclusion.FindKey("p");
+        if (!pattern || !pattern->is_string()) {
+          continue;
+        }
+        std::unique_ptr<re2::RE2> regexp =
+            CompilePattern(CorrectToRuleToRE2Engine(pattern->GetString()));
+        if (regexp) {
+          target.exclusions.push_back(std::move(regexp));
+        }
+      }
+    }
+
+    const base::Value* rules = top_value.FindKey("r");
+    target.has_rules = rules && rules->is_list();
+    if (target.has_rules) {
+      for (const base::Value& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict()) {
+          continue;
+        }
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.default_upgrade = true;
+          target.rules.push_back(std::move(rule));
+          continue;
+        }
+        const base::Value* from = rule_value.FindKey("f");
+        const base::Value* to = rule_value.FindKey("t");
+        if (!from || !from->is_string() || !to || !to->is_string()) {
+          continue;
+        }
+        rule.from = CompilePattern(from->GetString());
+        if (!rule.from) {
+          continue;
+        }
+        rule.to = CorrectToRuleToRE2Engine(to->GetString());
+        target.rules.push_back(std::move(rule));
+      }
+    }
+
+    ruleset->targets_.push_back(std::move(target));
+  }
+  return ruleset;
+}
+
+// static
+std::string HTTPSERuleset::CorrectToRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+std::string HTTPSERuleset::Apply(const std::string& original_url) const {
+  for (const Target& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(original_url, *exclusion)) {
+        return "";
+      }
+    }
+
+    if (!target.has_rules) {
+      return "";
+    }
+
+    for (const Rule& rule : target.rules) {
+      if (rule.default_upgrade) {
+        std::string new_url(original_url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(original_url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != original_url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
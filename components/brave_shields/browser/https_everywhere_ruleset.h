@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The HTTPS Everywhere rules stored for one lookup domain, parsed from their
+// JSON form with every regular expression compiled up front. Immutable once
+// parsed, so it can be shared between threads and reused across lookups.
+class HTTPSERuleset : public base::RefCountedThreadSafe<HTTPSERuleset> {
+ public:
+  // Returns nullptr if |json| is not a valid ruleset.
+  static scoped_refptr<HTTPSERuleset> Parse(const std::string& json);
+
+  // Converts the $1-style back-references used by HTTPS Everywhere into the
+  // \1 form understood by RE2.
+  static std::string CorrectToRuleToRE2Engine(const std::string& to);
+
+  // Returns the upgraded URL, or an empty string if no rule applies.
+  std::string Apply(const std::string& original_url) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSERuleset>;
+
+  struct Rule {
+    Rule();
+    Rule(Rule&& other);
+    ~Rule();
+
+    // Set for rules that upgrade any URL by switching http to https.
+    bool default_upgrade;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&& other);
+    ~Target();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // A target without a rule list ends the lookup.
+    bool has_rules;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleset();
+  ~HTTPSERuleset();
+
+  std::vector<Target> targets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleset);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
@@ -0,0 +1,46 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleset;
+
+TEST(HTTPSEverywhereRulesetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSERuleset::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleset::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, DefaultUpgrade) {
+  scoped_refptr<HTTPSERuleset> ruleset =
+      HTTPSERuleset::Parse("[{\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ(ruleset->Apply("http://a.com/"), "https://a.com/");
+}
+
+TEST(HTTPSEverywhereRulesetTest, RewriteAndExclusion) {
+  scoped_refptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(
+      "[{\"e\": [{\"p\": \"^http://www\\\\.a\\\\.com/skip\"}],"
+      "  \"r\": [{\"f\": \"^http://(www\\\\.)?a\\\\.com/\","
+      "          \"t\": \"https://$1a.com/\"}]}]");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ(ruleset->Apply("http://www.a.com/page"),
+            "https://www.a.com/page");
+  EXPECT_EQ(ruleset->Apply("http://a.com/page"), "https://a.com/page");
+  // Excluded URLs are left alone.
+  EXPECT_EQ(ruleset->Apply("http://www.a.com/skip"), "");
+  // URLs the rule doesn't match are left alone.
+  EXPECT_EQ(ruleset->Apply("http://b.com/"), "");
+  // Applying the ruleset again reuses the compiled rules.
+  EXPECT_EQ(ruleset->Apply("http://a.com/again"), "https://a.com/again");
+}
+
+TEST(HTTPSEverywhereRulesetTest, InvalidRegexNeverMatches) {
+  scoped_refptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(
+      "[{\"r\": [{\"f\": \"(\", \"t\": \"https://a.com/\"}]}]");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ(ruleset->Apply("http://a.com/"), "");
+}
@@ -11,69 +11,94 @@
 #include <vector>
 
 #include "base/base_paths.h"
-#include "base/json/json_reader.h"
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "base/time/default_tick_clock.h"
+#include "brave/common/brave_switches.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
 #include "chrome/browser/browser_process.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
+#define TRIE_FILE "httpse.trie"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_URL_REDIRECTS_TTL_SECONDS    60
+#define HTTPSE_RULESET_CACHE_SIZE           1000
 
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delim) {
-  std::stringstream ss(s);
-  std::string item;
-  std::vector<std::string> result;
-  while (getline(ss, item, delim)) {
-    result.push_back(item);
+size_t GetResultCacheSize() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  size_t size = 0;
+  if (base::StringToSizeT(command_line.GetSwitchValueASCII(
+          switches::kHTTPSEverywhereResultCacheSize), &size) && size > 0) {
+    return size;
   }
-  return result;
+  return brave_shields::HTTPSEverywhereResultCache::kDefaultSize;
 }
 
-// returns parts in reverse order, makes list of lookup domains like com.foo.*
-std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
-  std::vector<std::string> resultDomains;
-  std::vector<std::string> domainParts = Split(domain, '.');
-  if (domainParts.empty()) {
-    return resultDomains;
+// Converts the ruleset database shipped in the component into the trie
+// format read by HTTPSETrie. This only runs once per component version.
+bool BuildTrieFromLevelDB(const base::FilePath& zip_db_file_path,
+                          const base::FilePath& trie_file_path) {
+  base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
+  base::FilePath destination = zip_db_file_path.DirName();
+  if (!zip::Unzip(zip_db_file_path, destination)) {
+    LOG(ERROR) << "Failed to unzip database file "
+               << zip_db_file_path.value().c_str();
+    return false;
   }
 
-  for (size_t i = 0; i < domainParts.size() - 1; i++) {
-    // i < size()-1 is correct: don't want 'com.*' added to resultDomains
-    std::string slice = "";
-    std::string dot = "";
-    for (int j = domainParts.size() - 1; j >= static_cast<int>(i); j--) {
-      slice += dot + domainParts[j];
-      dot = ".";
-    }
-    if (0 != i) {
-      // We don't want * on the top URL
-      resultDomains.push_back(slice + ".*");
-    } else {
-      resultDomains.push_back(slice);
-    }
+  leveldb::DB* level_db = nullptr;
+  leveldb::Options options;
+  leveldb::Status status =
+      leveldb::DB::Open(options,
+                        unzipped_level_db_path.AsUTF8Unsafe(),
+                        &level_db);
+  if (!status.ok() || !level_db) {
+    LOG(ERROR) << "Level db open error "
+               << unzipped_level_db_path.value().c_str()
+               << ", error: " << status.ToString();
+    delete level_db;
+    return false;
   }
-  return resultDomains;
-}
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
+
+  brave_shields::HTTPSETrieBuilder builder;
+  std::unique_ptr<leveldb::Iterator> it(
+      level_db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    builder.Add(base::StringPiece(it->key().data(), it->key().size()),
+                base::StringPiece(it->value().data(), it->value().size()));
+  }
+  status = it->status();
+  it.reset();
+  delete level_db;
+  base::DeleteFile(unzipped_level_db_path, true);
+  if (!status.ok()) {
+    LOG(ERROR) << "Level db read error "
+               << unzipped_level_db_path.value().c_str()
+               << ", error: " << status.ToString();
+    return false;
   }
 
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
+  if (!base::ImportantFileWriter::WriteFileAtomically(trie_file_path,
+                                                      builder.Serialize())) {
+    LOG(ERROR) << "Failed to write HTTPSE trie "
+               << trie_file_path.value().c_str();
+    return false;
+  }
+  return true;
 }
 
 }  // namespace
@@ -87,7 +112,13 @@ std::string
 HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
     kHTTPSEverywhereComponentBase64PublicKey);
 
-HTTPSEverywhereService::HTTPSEverywhereService() : level_db_(nullptr) {
+HTTPSEverywhereService::HTTPSEverywhereService()
+    : redirect_tracker_(
+          HTTPSE_URL_MAX_REDIRECTS_COUNT,
+          base::TimeDelta::FromSeconds(HTTPSE_URL_REDIRECTS_TTL_SECONDS),
+          base::DefaultTickClock::GetInstance()),
+      result_cache_(GetResultCacheSize()),
+      ruleset_cache_(HTTPSE_RULESET_CACHE_SIZE) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -112,29 +143,42 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath zip_db_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
-  base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
-  base::FilePath destination = zip_db_file_path.DirName();
-  if (!zip::Unzip(zip_db_file_path, destination)) {
-    LOG(ERROR) << "Failed to unzip database file "
-               << zip_db_file_path.value().c_str();
-    return;
+  base::FilePath trie_file_path =
+      install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(TRIE_FILE);
+
+  if (base::PathExists(trie_file_path)) {
+    if (LoadTrie(trie_file_path)) {
+      return;
+    }
+    // Most likely written by an older version of the trie format, rebuild it.
+    base::DeleteFile(trie_file_path, false);
   }
 
-  CloseDatabase();
+  if (!BuildTrieFromLevelDB(zip_db_file_path, trie_file_path) ||
+      !LoadTrie(trie_file_path)) {
+    LOG(ERROR) << "Failed to load HTTPSE rules from "
+               << install_dir.value().c_str();
+  }
+}
 
-  leveldb::Options options;
-  leveldb::Status status =
-      leveldb::DB::Open(options,
-                        unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
-    level_db_ = nullptr;
-    LOG(ERROR) << "Level db open error "
-               << unzipped_level_db_path.value().c_str()
-               << ", error: " << status.ToString();
-    CloseDatabase();
-    return;
+bool HTTPSEverywhereService::LoadTrie(const base::FilePath& trie_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto trie_file = std::make_unique<base::MemoryMappedFile>();
+  if (!trie_file->Initialize(trie_file_path)) {
+    return false;
+  }
+  std::unique_ptr<HTTPSETrie> trie = HTTPSETrie::FromData(base::StringPiece(
+      reinterpret_cast<const char*>(trie_file->data()), trie_file->length()));
+  if (!trie) {
+    return false;
   }
+
+  CloseDatabase();
+  ruleset_cache_.clear();
+  result_cache_.Clear();
+  trie_file_ = std::move(trie_file);
+  trie_ = std::move(trie);
+  return true;
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -156,14 +200,20 @@ bool HTTPSEverywhereService::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!IsInitialized() || !trie_ || url->scheme() == url::kHttpsScheme) {
     return false;
   }
   if (!ShouldHTTPSERedirect(request_identifier)) {
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), &new_url)) {
+  // Results are cached under the URL as requested, even when a different
+  // candidate URL is matched, since that's what GetHTTPSURLFromCacheOnly()
+  // looks up.
+  if (result_cache_.Get(url->spec(), &new_url)) {
+    if (new_url.empty()) {
+      return false;
+    }
     AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
@@ -175,20 +225,21 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
-  const std::vector<std::string> domains =
-      ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+  HTTPSETrie::Match matches[HTTPSETrie::kMaxMatches];
+  size_t match_count = trie_->Find(candidate_url.host_piece(), matches);
+  for (size_t i = 0; i < match_count; i++) {
+    scoped_refptr<HTTPSERuleset> ruleset = GetRuleset(matches[i]);
+    if (ruleset) {
+      new_url = ruleset->Apply(candidate_url.spec());
       if (0 != new_url.length()) {
-        recently_used_cache_.add(candidate_url.spec(), new_url);
+        result_cache_.Put(url->spec(), new_url);
         AddHTTPSEUrlToRedirectList(request_identifier);
         return true;
       }
     }
   }
-  recently_used_cache_.remove(candidate_url.spec());
+  new_url.clear();
+  result_cache_.Put(url->spec(), new_url);
   return false;
 }
 
@@ -196,183 +247,53 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     const GURL* url,
     const uint64_t& request_identifier,
     std::string& cached_url) {
+  // Every early return below is also a "no upgrade" answer from GetHTTPSURL,
+  // so the caller doesn't need to ask the task runner again.
   if (!url->is_valid())
-    return false;
+    return true;
 
   if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
-    return false;
+    return true;
   }
   if (!ShouldHTTPSERedirect(request_identifier)) {
-    return false;
+    return true;
   }
 
-  if (recently_used_cache_.get(url->spec(), &cached_url)) {
+  if (!result_cache_.Get(url->spec(), &cached_url)) {
+    return false;
+  }
+  if (!cached_url.empty()) {
     AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
   }
-  return false;
+  return true;
 }
 
 bool HTTPSEverywhereService::ShouldHTTPSERedirect(
     const uint64_t& request_identifier) {
-  std::lock_guard<std::mutex> guard(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
-  }
-
-  return true;
+  return redirect_tracker_.ShouldRedirect(request_identifier);
 }
 
 void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
     const uint64_t& request_identifier) {
-  // Adding redirects count for the current request
-  std::lock_guard<std::mutex> guard(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
-      }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
-  }
-}
-
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::ListStorage& topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
+  redirect_tracker_.AddRedirect(request_identifier);
 }
 
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
+scoped_refptr<HTTPSERuleset> HTTPSEverywhereService::GetRuleset(
+    const HTTPSETrie::Match& match) {
+  scoped_refptr<HTTPSERuleset> ruleset;
+  if (ruleset_cache_.get(match.id, &ruleset)) {
+    return ruleset;
   }
 
-  return correctedto;
+  ruleset = HTTPSERuleset::Parse(match.value.as_string());
+  ruleset_cache_.add(match.id, ruleset);
+  return ruleset;
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
-  }
+  trie_.reset();
+  trie_file_.reset();
 }
 
 // static
@@ -10,16 +10,19 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <mutex>
 
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_tracker.h"
+#include "brave/components/brave_shields/browser/https_everywhere_result_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "brave/components/brave_shields/browser/https_everywhere_trie.h"
 #include "content/public/common/resource_type.h"
 
-namespace leveldb {
-class DB;
+namespace base {
+class MemoryMappedFile;
 }
 
 class HTTPSEverywhereServiceTest;
@@ -38,24 +41,14 @@ const std::string kHTTPSEverywhereComponentBase64PublicKey =
     "OtZqgfRg8Da4i+NwmjQqrz0JFtPMMSyUnmeMj+mSOL4xZVWr8fU2/GOCXs9gczDp"
     "JwIDAQAB";
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
-public:
-    HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-        unsigned int redirects):
-      request_identifier_(request_identifier),
-      redirects_(redirects) {
-    }
-
-    uint64_t request_identifier_;
-    unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService {
  public:
    HTTPSEverywhereService();
    ~HTTPSEverywhereService() override;
   bool GetHTTPSURL(const GURL* url, const uint64_t& request_id,
       std::string& new_url);
+  // Returns false if only GetHTTPSURL can answer for |url|. Otherwise
+  // |cached_url| is the upgraded URL, or empty if |url| isn't upgraded.
   bool GetHTTPSURLFromCacheOnly(const GURL* url,
       const uint64_t& request_id, std::string& cached_url);
 
@@ -68,9 +61,9 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled form of |match|, or nullptr if it isn't a valid
+  // ruleset. Rulesets are parsed once and cached until the next update.
+  scoped_refptr<HTTPSERuleset> GetRuleset(const HTTPSETrie::Match& match);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -85,11 +78,16 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
-
-  std::mutex httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
-  HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
-  leveldb::DB* level_db_;
+  bool LoadTrie(const base::FilePath& trie_file_path);
+
+  HTTPSERedirectTracker redirect_tracker_;
+  // Shared by the IO thread and the task runner.
+  HTTPSEverywhereResultCache result_cache_;
+  // Keyed by HTTPSETrie::Match::id.
+  HTTPSERecentlyUsedCache<scoped_refptr<HTTPSERuleset>, uint32_t>
+      ruleset_cache_;
+  std::unique_ptr<base::MemoryMappedFile> trie_file_;
+  std::unique_ptr<HTTPSETrie> trie_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
@@ -0,0 +1,258 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_trie.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/containers/queue.h"
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+
+namespace {
+
+const uint32_t kTrieMagic = 0x45535448;  // "HTSE"
+const uint32_t kTrieVersion = 1;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t node_count;
+  uint32_t string_pool_size;
+};
+
+const char kWildcardLabel[] = "*";
+
+}  // namespace
+
+namespace brave_shields {
+
+struct HTTPSETrie::Node {
+  uint32_t first_child;
+  uint32_t child_count;
+  uint32_t label_offset;
+  uint32_t label_length;
+  uint32_t exact_value_offset;
+  uint32_t exact_value_length;
+  uint32_t wildcard_value_offset;
+  uint32_t wildcard_value_length;
+};
+
+HTTPSETrie::HTTPSETrie(base::StringPiece data)
+    : data_(data),
+      nodes_(nullptr),
+      node_count_(0),
+      string_pool_(nullptr),
+      string_pool_size_(0) {
+}
+
+HTTPSETrie::~HTTPSETrie() {
+}
+
+// static
+std::unique_ptr<HTTPSETrie> HTTPSETrie::FromData(base::StringPiece data) {
+  std::unique_ptr<HTTPSETrie> trie(new HTTPSETrie(data));
+  if (!trie->Init()) {
+    return nullptr;
+  }
+  return trie;
+}
+
+bool HTTPSETrie::Init() {
+  if (data_.size() < sizeof(Header) ||
+      reinterpret_cast<uintptr_t>(data_.data()) % alignof(Node) != 0) {
+    return false;
+  }
+  Header header;
+  memcpy(&header, data_.data(), sizeof(Header));
+  if (header.magic != kTrieMagic || header.version != kTrieVersion ||
+      header.node_count == 0) {
+    return false;
+  }
+  uint64_t nodes_size = static_cast<uint64_t>(header.node_count) * sizeof(Node);
+  if (sizeof(Header) + nodes_size + header.string_pool_size != data_.size()) {
+    return false;
+  }
+
+  nodes_ = reinterpret_cast<const Node*>(data_.data() + sizeof(Header));
+  node_count_ = header.node_count;
+  string_pool_ = data_.data() + sizeof(Header) + nodes_size;
+  string_pool_size_ = header.string_pool_size;
+
+  // Check every reference once up front so lookups don't have to.
+  auto in_pool = [this](uint32_t offset, uint32_t length) {
+    return static_cast<uint64_t>(offset) + length <= string_pool_size_;
+  };
+  for (uint32_t i = 0; i < node_count_; i++) {
+    const Node& node = nodes_[i];
+    if ((node.child_count != 0 && node.first_child <= i) ||
+        static_cast<uint64_t>(node.first_child) + node.child_count >
+            node_count_ ||
+        !in_pool(node.label_offset, node.label_length) ||
+        !in_pool(node.exact_value_offset, node.exact_value_length) ||
+        !in_pool(node.wildcard_value_offset, node.wildcard_value_length)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+base::StringPiece HTTPSETrie::GetString(uint32_t offset,
+                                        uint32_t length) const {
+  return base::StringPiece(string_pool_ + offset, length);
+}
+
+const HTTPSETrie::Node* HTTPSETrie::FindChild(const Node* node,
+                                              base::StringPiece label) const {
+  const Node* first = nodes_ + node->first_child;
+  const Node* last = first + node->child_count;
+  const Node* it = std::lower_bound(first, last, label,
+      [this](const Node& child, base::StringPiece label) {
+        return GetString(child.label_offset, child.label_length) < label;
+      });
+  if (it == last || GetString(it->label_offset, it->label_length) != label) {
+    return nullptr;
+  }
+  return it;
+}
+
+size_t HTTPSETrie::Find(base::StringPiece host,
+                        Match matches[kMaxMatches]) const {
+  // A trailing dot doesn't add a label.
+  if (!host.empty() && host.back() == '.') {
+    host.remove_suffix(1);
+  }
+
+  // Walk the labels from the top-level domain down, remembering each node
+  // with a wildcard ruleset. Wildcards never apply to the top-level domain
+  // alone nor to the full host, and exact rulesets need at least two labels.
+  const Node* wildcard_nodes[kMaxMatches];
+  size_t wildcard_count = 0;
+  const Node* node = nodes_;
+  size_t depth = 0;
+  size_t end = host.size();
+  bool has_more_labels = !host.empty();
+  while (has_more_labels && node) {
+    size_t dot = end == 0 ? base::StringPiece::npos : host.rfind('.', end - 1);
+    size_t start = dot == base::StringPiece::npos ? 0 : dot + 1;
+    base::StringPiece label = host.substr(start, end - start);
+    has_more_labels = dot != base::StringPiece::npos;
+    end = has_more_labels ? dot : 0;
+
+    node = FindChild(node, label);
+    depth++;
+    if (node && has_more_labels && depth >= 2 &&
+        node->wildcard_value_length != 0 && wildcard_count < kMaxMatches - 1) {
+      wildcard_nodes[wildcard_count++] = node;
+    }
+  }
+
+  size_t count = 0;
+  if (node && !has_more_labels && depth >= 2 &&
+      node->exact_value_length != 0) {
+    matches[count++] = {
+        node->exact_value_offset,
+        GetString(node->exact_value_offset, node->exact_value_length)};
+  }
+  while (wildcard_count > 0) {
+    const Node* wildcard_node = wildcard_nodes[--wildcard_count];
+    matches[count++] = {
+        wildcard_node->wildcard_value_offset,
+        GetString(wildcard_node->wildcard_value_offset,
+                  wildcard_node->wildcard_value_length)};
+  }
+  return count;
+}
+
+HTTPSETrieBuilder::BuilderNode::BuilderNode() {
+}
+
+HTTPSETrieBuilder::BuilderNode::~BuilderNode() {
+}
+
+HTTPSETrieBuilder::HTTPSETrieBuilder() {
+}
+
+HTTPSETrieBuilder::~HTTPSETrieBuilder() {
+}
+
+void HTTPSETrieBuilder::Add(base::StringPiece key, base::StringPiece value) {
+  std::vector<base::StringPiece> labels = base::SplitStringPiece(
+      key, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  bool wildcard = labels.size() > 1 && labels.back() == kWildcardLabel;
+  if (wildcard) {
+    labels.pop_back();
+  }
+
+  BuilderNode* node = &root_;
+  for (const auto& label : labels) {
+    std::unique_ptr<BuilderNode>& child = node->children[label.as_string()];
+    if (!child) {
+      child = std::make_unique<BuilderNode>();
+    }
+    node = child.get();
+  }
+  if (wildcard) {
+    node->wildcard_value = value.as_string();
+  } else {
+    node->exact_value = value.as_string();
+  }
+}
+
+std::string HTTPSETrieBuilder::Serialize() const {
+  std::vector<HTTPSETrie::Node> nodes;
+  std::string string_pool;
+  auto add_string = [&string_pool](const std::string& value,
+                                   uint32_t* offset, uint32_t* length) {
+    *offset = static_cast<uint32_t>(string_pool.size());
+    *length = static_cast<uint32_t>(value.size());
+    string_pool.append(value);
+  };
+
+  // Lay the nodes out breadth-first so that the children of each node are
+  // contiguous and, coming from a std::map, sorted by label.
+  base::queue<std::pair<const std::string*, const BuilderNode*>> queue;
+  const std::string empty_label;
+  queue.push(std::make_pair(&empty_label, &root_));
+  uint32_t next_index = 1;
+  while (!queue.empty()) {
+    const std::string* label = queue.front().first;
+    const BuilderNode* builder_node = queue.front().second;
+    queue.pop();
+
+    HTTPSETrie::Node node = {};
+    node.first_child = builder_node->children.empty() ? 0 : next_index;
+    node.child_count = static_cast<uint32_t>(builder_node->children.size());
+    next_index += node.child_count;
+    add_string(*label, &node.label_offset, &node.label_length);
+    add_string(builder_node->exact_value, &node.exact_value_offset,
+               &node.exact_value_length);
+    add_string(builder_node->wildcard_value, &node.wildcard_value_offset,
+               &node.wildcard_value_length);
+    nodes.push_back(node);
+
+    for (const auto& child : builder_node->children) {
+      queue.push(std::make_pair(&child.first, child.second.get()));
+    }
+  }
+
+  Header header = {kTrieMagic, kTrieVersion,
+                   static_cast<uint32_t>(nodes.size()),
+                   static_cast<uint32_t>(string_pool.size())};
+  std::string result;
+  result.reserve(sizeof(Header) + nodes.size() * sizeof(HTTPSETrie::Node) +
+                 string_pool.size());
+  result.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+  result.append(reinterpret_cast<const char*>(nodes.data()),
+                nodes.size() * sizeof(HTTPSETrie::Node));
+  result.append(string_pool);
+  return result;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,100 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_TRIE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_TRIE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// A read-only trie of reversed domain labels mapping HTTPS Everywhere lookup
+// domains ("com.foo" or "com.foo.*") to their ruleset JSON. The serialized
+// form is used in place, so the trie can be memory-mapped, and a lookup
+// walks the labels of a host once without allocating.
+//
+// Layout, in native byte order since the file is built on the device:
+//   header       4 x uint32_t: magic, version, node count, string pool size
+//   nodes        node count x Node; the root comes first and the children
+//                of each node are stored contiguously, sorted by label
+//   string pool  labels and ruleset values, referenced by offset and length
+class HTTPSETrie {
+ public:
+  struct Match {
+    // Identifies the value within this trie, e.g. for caching.
+    uint32_t id;
+    base::StringPiece value;
+  };
+
+  // One exact match plus at most one wildcard match per label of a host,
+  // which DNS limits to 127.
+  static const size_t kMaxMatches = 128;
+
+  ~HTTPSETrie();
+
+  // Returns nullptr if |data| doesn't hold a valid trie. |data| must outlive
+  // the returned trie.
+  static std::unique_ptr<HTTPSETrie> FromData(base::StringPiece data);
+
+  // Fills |matches| with the rulesets that apply to |host|, most specific
+  // first, in the same order the LevelDB lookup domains used to be tried.
+  // Returns the number of matches.
+  size_t Find(base::StringPiece host, Match matches[kMaxMatches]) const;
+
+ private:
+  friend class HTTPSETrieBuilder;
+  struct Node;
+
+  explicit HTTPSETrie(base::StringPiece data);
+  bool Init();
+  const Node* FindChild(const Node* node, base::StringPiece label) const;
+  base::StringPiece GetString(uint32_t offset, uint32_t length) const;
+
+  base::StringPiece data_;
+  const Node* nodes_;
+  uint32_t node_count_;
+  const char* string_pool_;
+  uint32_t string_pool_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSETrie);
+};
+
+// Builds the serialized form read by HTTPSETrie.
+class HTTPSETrieBuilder {
+ public:
+  HTTPSETrieBuilder();
+  ~HTTPSETrieBuilder();
+
+  // |key| is a lookup domain in the LevelDB key format, e.g. "com.foo" or
+  // "com.foo.*".
+  void Add(base::StringPiece key, base::StringPiece value);
+  std::string Serialize() const;
+
+ private:
+  struct BuilderNode {
+    BuilderNode();
+    ~BuilderNode();
+
+    std::map<std::string, std::unique_ptr<BuilderNode>> children;
+    std::string exact_value;
+    std::string wildcard_value;
+  };
+
+  BuilderNode root_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSETrieBuilder);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_TRIE_H_
@@ -0,0 +1,79 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_trie.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSETrie;
+using brave_shields::HTTPSETrieBuilder;
+
+namespace {
+
+std::vector<std::string> Find(const HTTPSETrie& trie, const char* host) {
+  HTTPSETrie::Match matches[HTTPSETrie::kMaxMatches];
+  size_t count = trie.Find(host, matches);
+  std::vector<std::string> values;
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(matches[i].value.as_string());
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(HTTPSEverywhereTrieTest, MatchesLookupDomainOrder) {
+  HTTPSETrieBuilder builder;
+  builder.Add("com.foo", "foo");
+  builder.Add("com.foo.*", "*.foo");
+  builder.Add("com.foo.www", "www.foo");
+  builder.Add("com.foo.www.x.*", "*.x.www.foo");
+  builder.Add("com.*", "*.com");
+  const std::string data = builder.Serialize();
+  std::unique_ptr<HTTPSETrie> trie = HTTPSETrie::FromData(data);
+  ASSERT_TRUE(trie);
+
+  EXPECT_EQ(Find(*trie, "foo.com"), std::vector<std::string>({"foo"}));
+  EXPECT_EQ(Find(*trie, "foo.com."), std::vector<std::string>({"foo"}));
+  EXPECT_EQ(Find(*trie, "www.foo.com"),
+            std::vector<std::string>({"www.foo", "*.foo"}));
+  EXPECT_EQ(Find(*trie, "a.b.www.foo.com"),
+            std::vector<std::string>({"*.foo"}));
+  EXPECT_EQ(Find(*trie, "y.x.www.foo.com"),
+            std::vector<std::string>({"*.x.www.foo", "*.foo"}));
+  // Wildcards on the top-level domain alone are never looked up.
+  EXPECT_TRUE(Find(*trie, "bar.com").empty());
+  EXPECT_TRUE(Find(*trie, "com").empty());
+  EXPECT_TRUE(Find(*trie, "").empty());
+}
+
+TEST(HTTPSEverywhereTrieTest, MatchIdsAreStable) {
+  HTTPSETrieBuilder builder;
+  builder.Add("com.foo.*", "*.foo");
+  const std::string data = builder.Serialize();
+  std::unique_ptr<HTTPSETrie> trie = HTTPSETrie::FromData(data);
+  ASSERT_TRUE(trie);
+
+  HTTPSETrie::Match first[HTTPSETrie::kMaxMatches];
+  HTTPSETrie::Match second[HTTPSETrie::kMaxMatches];
+  ASSERT_EQ(trie->Find("a.foo.com", first), 1u);
+  ASSERT_EQ(trie->Find("b.foo.com", second), 1u);
+  EXPECT_EQ(first[0].id, second[0].id);
+}
+
+TEST(HTTPSEverywhereTrieTest, RejectsInvalidData) {
+  HTTPSETrieBuilder builder;
+  builder.Add("com.foo", "foo");
+  const std::string data = builder.Serialize();
+  EXPECT_FALSE(HTTPSETrie::FromData(std::string()));
+  EXPECT_FALSE(HTTPSETrie::FromData(data.substr(0, data.size() - 1)));
+  std::string corrupted(data);
+  corrupted[0] ^= 0xff;
+  EXPECT_FALSE(HTTPSETrie::FromData(corrupted));
+}
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 
 #include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "base/base_paths.h"
@@ -14,6 +15,8 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -24,7 +27,6 @@
 #include "brave/vendor/tracking-protection/TPParser.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-#include "base/strings/string_split.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -46,15 +48,96 @@ const char kNavigationTrackersFile[] = "TrackingProtection.dat";
 const char kStorageTrackersFile[] = "StorageTrackingProtection.dat";
 #endif
 
-const int kThirdPartyHostsCacheSize = 20;
+// Most first party hosts have no entry in the list, so this mostly bounds
+// the empty entries for the distinct sites the user visits.
+const size_t kFirstPartyHostsCacheSize = 1000;
+// Lookups come from the IO thread and the task runner, so the cache is split
+// into independently locked shards to keep them from contending.
+const size_t kFirstPartyHostsShardCount = 8;
+
+namespace {
+
+// Returns true if |host| is |domain| or one of its subdomains.
+bool IsSameOrSubdomain(base::StringPiece host, base::StringPiece domain) {
+  if (!base::EndsWith(host, domain, base::CompareCase::SENSITIVE)) {
+    return false;
+  }
+  return host.size() == domain.size() ||
+         host[host.size() - domain.size() - 1] == '.';
+}
+
+}  // namespace
+
+TrackingProtectionService::TrackerList::FirstPartyHostsShard::
+    FirstPartyHostsShard(size_t size)
+    : entries(size) {}
+
+TrackingProtectionService::TrackerList::FirstPartyHostsShard::
+    ~FirstPartyHostsShard() {}
+
+TrackingProtectionService::TrackerList::TrackerList(
+    std::unique_ptr<CTPParser> parser,
+    DATFileDataBuffer buffer)
+    : parser_(std::move(parser)),
+      buffer_(std::move(buffer)) {
+  for (size_t i = 0; i < kFirstPartyHostsShardCount; i++) {
+    first_party_hosts_.push_back(std::make_unique<FirstPartyHostsShard>(
+        kFirstPartyHostsCacheSize / kFirstPartyHostsShardCount));
+  }
+}
+
+TrackingProtectionService::TrackerList::~TrackerList() {}
+
+TrackingProtectionService::TrackerList::FirstPartyHostsShard*
+TrackingProtectionService::TrackerList::GetShard(
+    const std::string& first_party_host) {
+  return first_party_hosts_[std::hash<std::string>()(first_party_host) %
+                            first_party_hosts_.size()].get();
+}
+
+bool TrackingProtectionService::TrackerList::IsAllowedThirdParty(
+    const std::string& first_party_host,
+    const std::string& host) {
+  FirstPartyHostsShard* shard = GetShard(first_party_host);
+  base::AutoLock guard(shard->lock);
+  auto it = shard->entries.Get(first_party_host);
+  if (it == shard->entries.end()) {
+    it = shard->entries.Put(first_party_host,
+                            ParseFirstPartyHosts(first_party_host));
+  }
+
+  for (const std::string& third_party_host : it->second) {
+    if (IsSameOrSubdomain(host, third_party_host)) {
+      return true;
+    }
+  }
+  return false;
+}
 
-TrackingProtectionService::TrackingProtectionService()
-    : tracking_protection_client_(new CTPParser()), weak_factory_(this) {
+// Ported from Android: net/blockers/blockers_worker.cc
+std::vector<std::string>
+TrackingProtectionService::TrackerList::ParseFirstPartyHosts(
+    const std::string& first_party_host) const {
+  std::unique_ptr<char[]> third_party_hosts(
+      parser_->findFirstPartyHosts(first_party_host.c_str()));
+  if (!third_party_hosts) {
+    return std::vector<std::string>();
+  }
+  return base::SplitString(third_party_hosts.get(), ",",
+                           base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+}
+
+TrackingProtectionService::TrackingProtectionService() : weak_factory_(this) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 TrackingProtectionService::~TrackingProtectionService() {
-  tracking_protection_client_.reset();
+}
+
+scoped_refptr<TrackingProtectionService::TrackerList>
+TrackingProtectionService::GetTrackerList() {
+  base::AutoLock guard(tracker_list_lock_);
+  return tracker_list_;
 }
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
@@ -226,43 +309,51 @@ bool TrackingProtectionService::ShouldStartRequest(
     *matching_exception_filter = false;
   }
   // Intentionally don't set cancel_request_explicitly
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  scoped_refptr<TrackerList> tracker_list = GetTrackerList();
+  if (!tracker_list) {
+    return true;
+  }
   std::string host = url.host();
-  if (!tracking_protection_client_->matchesTracker(tab_host.c_str(),
-                                                   host.c_str())) {
+  if (!tracker_list->parser()->matchesTracker(tab_host.c_str(),
+                                              host.c_str())) {
     return true;
   }
 
-  std::vector<std::string> hosts(GetThirdPartyHosts(tab_host));
-  for (size_t i = 0; i < hosts.size(); i++) {
-    if (host == hosts[i] ||
-        host.find((std::string) "." + hosts[i]) != std::string::npos) {
-      return true;
-    }
-    size_t iPos = host.find((std::string) "." + hosts[i]);
-    if (iPos == std::string::npos) {
-      continue;
-    }
-    if (hosts[i].length() + ((std::string) ".").length() + iPos ==
-        host.length()) {
-      return true;
-    }
+  return tracker_list->IsAllowedThirdParty(tab_host, host);
+}
+
+bool TrackingProtectionService::MatchesTracker(const GURL& url,
+                                               const std::string& tab_host) {
+  scoped_refptr<TrackerList> tracker_list = GetTrackerList();
+  if (!tracker_list) {
+    return false;
   }
-  return false;
+  return tracker_list->parser()->matchesTracker(tab_host.c_str(),
+                                                url.host().c_str());
 }
 
-void TrackingProtectionService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void TrackingProtectionService::LoadTrackerListOnFileTaskRunner(
+    const base::FilePath& dat_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DATFileDataBuffer buffer;
+  GetDATFileData(dat_file_path, &buffer);
+  if (buffer.empty()) {
     LOG(ERROR) << "Could not obtain tracking protection data";
     return;
   }
-  tracking_protection_client_.reset(new CTPParser());
-  if (!tracking_protection_client_->deserialize(
-          reinterpret_cast<char*>(&buffer_.front()))) {
-    tracking_protection_client_.reset();
+  auto parser = std::make_unique<CTPParser>();
+  if (!parser->deserialize(reinterpret_cast<char*>(&buffer.front()))) {
     LOG(ERROR) << "Failed to deserialize tracking protection data";
     return;
   }
+  // Moving the buffer keeps its heap allocation, so the parser's pointers
+  // into it stay valid.
+  auto tracker_list =
+      base::MakeRefCounted<TrackerList>(std::move(parser), std::move(buffer));
+  {
+    base::AutoLock guard(tracker_list_lock_);
+    tracker_list_.swap(tracker_list);
+  }
 }
 
 void TrackingProtectionService::OnComponentReady(
@@ -273,12 +364,11 @@ void TrackingProtectionService::OnComponentReady(
       install_dir.AppendASCII(kDatFileVersion)
           .AppendASCII(kNavigationTrackersFile);
 
-  GetTaskRunner()->PostTaskAndReply(
+  GetTaskRunner()->PostTask(
       FROM_HERE,
-      base::Bind(&GetDATFileData, navigation_tracking_protection_path,
-                 &buffer_),
-      base::Bind(&TrackingProtectionService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
+      base::BindOnce(
+          &TrackingProtectionService::LoadTrackerListOnFileTaskRunner,
+          base::Unretained(this), navigation_tracking_protection_path));
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
   if (!TrackingProtectionHelper::IsSmartTrackingProtectionEnabled()) {
@@ -297,62 +387,6 @@ void TrackingProtectionService::OnComponentReady(
 #endif
 }
 
-// Ported from Android: net/blockers/blockers_worker.cc
-std::vector<std::string> TrackingProtectionService::GetThirdPartyHosts(
-    const std::string& base_host) {
-  {
-    base::AutoLock guard(third_party_hosts_lock_);
-    std::map<std::string, std::vector<std::string>>::const_iterator iter =
-        third_party_hosts_cache_.find(base_host);
-    if (third_party_hosts_cache_.end() != iter) {
-      if (third_party_base_hosts_.size() != 0 &&
-          third_party_base_hosts_[third_party_hosts_cache_.size() - 1] !=
-              base_host) {
-        for (size_t i = 0; i < third_party_base_hosts_.size(); i++) {
-          if (third_party_base_hosts_[i] == base_host) {
-            third_party_base_hosts_.erase(third_party_base_hosts_.begin() + i);
-            third_party_base_hosts_.push_back(base_host);
-            break;
-          }
-        }
-      }
-      return iter->second;
-    }
-  }
-
-  char* thirdPartyHosts =
-      tracking_protection_client_->findFirstPartyHosts(base_host.c_str());
-  std::vector<std::string> hosts;
-  if (nullptr != thirdPartyHosts) {
-    std::string strThirdPartyHosts = thirdPartyHosts;
-    size_t iPos = strThirdPartyHosts.find(",");
-    while (iPos != std::string::npos) {
-      std::string thirdParty = strThirdPartyHosts.substr(0, iPos);
-      strThirdPartyHosts = strThirdPartyHosts.substr(iPos + 1);
-      iPos = strThirdPartyHosts.find(",");
-      hosts.push_back(thirdParty);
-    }
-    if (0 != strThirdPartyHosts.length()) {
-      hosts.push_back(strThirdPartyHosts);
-    }
-    delete []thirdPartyHosts;
-  }
-
-  {
-    base::AutoLock guard(third_party_hosts_lock_);
-    if (third_party_hosts_cache_.size() == kThirdPartyHostsCacheSize &&
-        third_party_base_hosts_.size() == kThirdPartyHostsCacheSize) {
-      third_party_hosts_cache_.erase(third_party_base_hosts_[0]);
-      third_party_base_hosts_.erase(third_party_base_hosts_.begin());
-    }
-    third_party_base_hosts_.push_back(base_host);
-    third_party_hosts_cache_.insert(
-        std::pair<std::string, std::vector<std::string>>(base_host, hosts));
-  }
-
-  return hosts;
-}
-
 scoped_refptr<base::SequencedTaskRunner>
 TrackingProtectionService::GetTaskRunner() {
   // We share the same task runner for all ad-block and TP code
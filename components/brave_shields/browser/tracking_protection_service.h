@@ -16,7 +16,9 @@
 #include <vector>
 
 #include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
@@ -43,11 +45,15 @@ class TrackingProtectionService : public BaseLocalDataFilesObserver {
   TrackingProtectionService();
   ~TrackingProtectionService() override;
 
+  // Safe to call from any thread.
   bool ShouldStartRequest(const GURL& spec,
                           content::ResourceType resource_type,
                           const std::string& tab_host,
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly);
+  // Returns false if ShouldStartRequest() would certainly allow the request.
+  // Only consults the tracker list, so it is cheap enough for the IO thread.
+  bool MatchesTracker(const GURL& url, const std::string& tab_host);
 
   bool ShouldStoreState(content_settings::BraveCookieSettings* settings,
                         HostContentSettingsMap* map,
@@ -109,8 +115,50 @@ class TrackingProtectionService : public BaseLocalDataFilesObserver {
 #endif
 
  private:
-  void OnDATFileDataReady();
-  std::vector<std::string> GetThirdPartyHosts(const std::string& base_host);
+  // The parsed tracker list and the DAT data it points into. Replaced as a
+  // unit on update, so requests matching on other threads never see a
+  // partially loaded list.
+  class TrackerList : public base::RefCountedThreadSafe<TrackerList> {
+   public:
+    TrackerList(std::unique_ptr<CTPParser> parser, DATFileDataBuffer buffer);
+
+    CTPParser* parser() const { return parser_.get(); }
+
+    // Returns true if |host| or one of its parent domains is a third party
+    // that |first_party_host| is allowed to load.
+    bool IsAllowedThirdParty(const std::string& first_party_host,
+                             const std::string& host);
+
+   private:
+    friend class base::RefCountedThreadSafe<TrackerList>;
+
+    // Allowed third party hosts by first party host, split out of the DAT
+    // the first time each first party host is seen. Hosts with no entry are
+    // kept as an empty list. The parser is never modified once loaded, so an
+    // entry stays valid for as long as this list is in use.
+    struct FirstPartyHostsShard {
+      explicit FirstPartyHostsShard(size_t size);
+      ~FirstPartyHostsShard();
+
+      base::Lock lock;
+      base::HashingMRUCache<std::string, std::vector<std::string>> entries;
+    };
+
+    ~TrackerList();
+
+    FirstPartyHostsShard* GetShard(const std::string& first_party_host);
+    std::vector<std::string> ParseFirstPartyHosts(
+        const std::string& first_party_host) const;
+
+    std::unique_ptr<CTPParser> parser_;
+    DATFileDataBuffer buffer_;
+    std::vector<std::unique_ptr<FirstPartyHostsShard>> first_party_hosts_;
+
+    DISALLOW_COPY_AND_ASSIGN(TrackerList);
+  };
+
+  void LoadTrackerListOnFileTaskRunner(const base::FilePath& dat_file_path);
+  scoped_refptr<TrackerList> GetTrackerList();
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
   base::flat_set<std::string> first_party_storage_trackers_;
@@ -118,12 +166,9 @@ class TrackingProtectionService : public BaseLocalDataFilesObserver {
 
   brave_shields::DATFileDataBuffer storage_trackers_buffer_;
 #endif
-  brave_shields::DATFileDataBuffer buffer_;
 
-  std::unique_ptr<CTPParser> tracking_protection_client_;
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  base::Lock third_party_hosts_lock_;
+  base::Lock tracker_list_lock_;
+  scoped_refptr<TrackerList> tracker_list_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
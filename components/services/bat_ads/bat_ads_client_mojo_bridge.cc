@@ -69,7 +69,8 @@ class LogStreamImpl : public ads::LogStream {
 }  // namespace
 
 BatAdsClientMojoBridge::BatAdsClientMojoBridge(
-    mojom::BatAdsClientAssociatedPtrInfo client_info) {
+    mojom::BatAdsClientAssociatedPtrInfo client_info)
+    : defer_saves_(false) {
   bat_ads_client_.Bind(std::move(client_info));
 }
 
@@ -124,9 +125,7 @@ void BatAdsClientMojoBridge::GetClientInfo(ads::ClientInfo* info) const {
   if (!connected())
     return;
 
-  std::string out_info_json;
-  bat_ads_client_->GetClientInfo(info->ToJson(), &out_info_json);
-  info->FromJson(out_info_json);
+  bat_ads_client_->GetClientInfo(*info, info);
 }
 
 const std::vector<std::string> BatAdsClientMojoBridge::GetLocales() const {
@@ -152,7 +151,7 @@ void BatAdsClientMojoBridge::ShowNotification(
   if (!connected())
     return;
 
-  bat_ads_client_->ShowNotification(info->ToJson());
+  bat_ads_client_->ShowNotification(*info);
 }
 
 void BatAdsClientMojoBridge::SetCatalogIssuers(
@@ -168,7 +167,7 @@ void BatAdsClientMojoBridge::ConfirmAd(
   if (!connected())
     return;
 
-  bat_ads_client_->ConfirmAd(info->ToJson());
+  bat_ads_client_->ConfirmAd(*info);
 }
 
 uint32_t BatAdsClientMojoBridge::SetTimer(const uint64_t time_offset) {
@@ -222,6 +221,12 @@ void OnSave(const ads::OnSaveCallback& callback,
 void BatAdsClientMojoBridge::Save(const std::string& name,
                                  const std::string& value,
                                  ads::OnSaveCallback callback) {
+  if (defer_saves_) {
+    deferred_saves_[name] = value;
+    callback(ads::Result::SUCCESS);
+    return;
+  }
+
   if (!connected()) {
     callback(ads::Result::FAILED);
     return;
@@ -260,7 +265,7 @@ void BatAdsClientMojoBridge::SaveBundleState(
     return;
   }
 
-  bat_ads_client_->SaveBundleState(bundle_state->ToJson(),
+  bat_ads_client_->SaveBundleState(*bundle_state,
       base::BindOnce(&OnSaveBundleState, std::move(callback)));
 }
 
@@ -292,19 +297,7 @@ void BatAdsClientMojoBridge::Reset(const std::string& name,
 void OnGetAds(const ads::OnGetAdsCallback& callback,
               int32_t result,
               const std::string& category,
-              const std::vector<std::string>& ad_info_json_list) {
-  std::vector<ads::AdInfo> ad_info_list;
-
-  for (const auto it : ad_info_json_list) {
-    ads::AdInfo ad_info;
-    if (ad_info.FromJson(it) == ads::Result::SUCCESS) {
-      ad_info_list.push_back(ad_info);
-    } else {
-      callback(ads::Result::FAILED, category, std::vector<ads::AdInfo>());
-      return;
-    }
-  }
-
+              const std::vector<ads::AdInfo>& ad_info_list) {
   callback(ToAdsResult(result), category, ad_info_list);
 }
 
@@ -395,6 +388,15 @@ bool BatAdsClientMojoBridge::IsNetworkConnectionAvailable() {
   return available;
 }
 
+void BatAdsClientMojoBridge::DeferSaves() {
+  defer_saves_ = true;
+}
+
+std::map<std::string, std::string>
+BatAdsClientMojoBridge::TakeDeferredSaves() {
+  return std::move(deferred_saves_);
+}
+
 bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 #define BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -68,11 +69,19 @@ class BatAdsClientMojoBridge : public ads::AdsClient {
       ads::OnLoadCallback callback) const override;
   bool IsNetworkConnectionAvailable() override;
 
+  // Keeps anything saved from now on for TakeDeferredSaves() instead of
+  // sending it through the client
+  void DeferSaves();
+  std::map<std::string, std::string> TakeDeferredSaves();
+
  private:
   bool connected() const;
 
   mojom::BatAdsClientAssociatedPtr bat_ads_client_;
 
+  bool defer_saves_;
+  std::map<std::string, std::string> deferred_saves_;
+
   DISALLOW_COPY_AND_ASSIGN(BatAdsClientMojoBridge);
 };
 
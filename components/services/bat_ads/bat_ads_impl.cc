@@ -9,6 +9,9 @@
 
 #include "bat/ads/ads.h"
 #include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+#include "mojo/public/cpp/bindings/map.h"
+
+using std::placeholders::_1;
 
 namespace bat_ads {
 
@@ -34,6 +37,30 @@ void BatAdsImpl::Initialize(InitializeCallback callback) {
   std::move(callback).Run();
 }
 
+// static
+void BatAdsImpl::OnShutdown(
+    CallbackHolder<ShutdownCallback>* holder,
+    BatAdsClientMojoBridge* client,
+    const ads::Result result) {
+  // |client| is owned by the BatAdsImpl that |holder| checks for
+  if (holder->is_valid())
+    std::move(holder->get()).Run(mojo::MapToFlatMap(
+        client->TakeDeferredSaves()));
+  delete holder;
+}
+
+void BatAdsImpl::Shutdown(ShutdownCallback callback) {
+  // The browser closes the client as soon as it asks to shut down, so the
+  // pending state is answered with instead
+  bat_ads_client_mojo_proxy_->DeferSaves();
+
+  // delete in OnShutdown
+  auto* holder = new CallbackHolder<ShutdownCallback>(
+      AsWeakPtr(), std::move(callback));
+  ads_->Shutdown(std::bind(BatAdsImpl::OnShutdown, holder,
+      bat_ads_client_mojo_proxy_.get(), _1));
+}
+
 void BatAdsImpl::ClassifyPage(const std::string& url,
                               const std::string& page) {
   ads_->ClassifyPage(url, page);
@@ -93,22 +120,16 @@ void BatAdsImpl::ServeSampleAd() {
 }
 
 void BatAdsImpl::GenerateAdReportingNotificationShownEvent(
-      const std::string& notification_info) {
-  auto info = std::make_unique<ads::NotificationInfo>();
-  if (info->FromJson(notification_info) == ads::Result::SUCCESS) {
-    ads_->GenerateAdReportingNotificationShownEvent(*info);
-  }
+      const ads::NotificationInfo& notification_info) {
+  ads_->GenerateAdReportingNotificationShownEvent(notification_info);
 }
 
 void BatAdsImpl::GenerateAdReportingNotificationResultEvent(
-      const std::string& notification_info,
+      const ads::NotificationInfo& notification_info,
       int32_t result_type) {
-  auto info = std::make_unique<ads::NotificationInfo>();
-  if (info->FromJson(notification_info) == ads::Result::SUCCESS) {
-    ads_->GenerateAdReportingNotificationResultEvent(
-        *info,
-        ToNotificationResultInfoResultType(result_type));
-  }
+  ads_->GenerateAdReportingNotificationResultEvent(
+      notification_info,
+      ToNotificationResultInfoResultType(result_type));
 }
 
 }  // namespace bat_ads
@@ -8,7 +8,10 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
+#include "base/memory/weak_ptr.h"
+#include "bat/ads/result.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 
@@ -20,13 +23,15 @@ namespace bat_ads {
 
 class BatAdsClientMojoBridge;
 
-class BatAdsImpl : public mojom::BatAds {
+class BatAdsImpl : public mojom::BatAds,
+    public base::SupportsWeakPtr<BatAdsImpl> {
  public:
   explicit BatAdsImpl(mojom::BatAdsClientAssociatedPtrInfo client_info);
   ~BatAdsImpl() override;
 
   // Overridden from mojom::BatAds:
   void Initialize(InitializeCallback callback) override;
+  void Shutdown(ShutdownCallback callback) override;
   void ClassifyPage(const std::string& url,
                     const std::string& page) override;
   void TabClosed(int32_t tab_id) override;
@@ -45,12 +50,33 @@ class BatAdsImpl : public mojom::BatAds {
   void SetConfirmationsIsReady(const bool is_ready) override;
   void ServeSampleAd() override;
   void GenerateAdReportingNotificationShownEvent(
-      const std::string& notification_info) override;
+      const ads::NotificationInfo& notification_info) override;
   void GenerateAdReportingNotificationResultEvent(
-      const std::string& notification_info,
+      const ads::NotificationInfo& notification_info,
       int32_t event_type) override;
 
  private:
+  // workaround to pass base::OnceCallback into std::bind
+  template <typename Callback>
+    class CallbackHolder {
+     public:
+      CallbackHolder(base::WeakPtr<BatAdsImpl> client,
+          Callback callback)
+        : client_(client),
+        callback_(std::move(callback)) {}
+      ~CallbackHolder() = default;
+      bool is_valid() { return !!client_.get(); }
+      Callback& get() { return callback_; }
+
+     private:
+      base::WeakPtr<BatAdsImpl> client_;
+      Callback callback_;
+    };
+
+  static void OnShutdown(CallbackHolder<ShutdownCallback>* holder,
+                         BatAdsClientMojoBridge* client,
+                         const ads::Result result);
+
   std::unique_ptr<BatAdsClientMojoBridge> bat_ads_client_mojo_proxy_;
   std::unique_ptr<ads::Ads> ads_;
 
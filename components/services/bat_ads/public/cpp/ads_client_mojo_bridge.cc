@@ -160,21 +160,18 @@ void AdsClientMojoBridge::KillTimer(uint32_t timer_id) {
   ads_client_->KillTimer(timer_id);
 }
 
-bool AdsClientMojoBridge::GetClientInfo(const std::string& client_info,
-                                     std::string* out_client_info) {
-  ads::ClientInfo info;
-  info.FromJson(client_info);
-  ads_client_->GetClientInfo(&info);
-  *out_client_info = info.ToJson();
+bool AdsClientMojoBridge::GetClientInfo(const ads::ClientInfo& client_info,
+                                     ads::ClientInfo* out_client_info) {
+  *out_client_info = client_info;
+  ads_client_->GetClientInfo(out_client_info);
   return true;
 }
 
-void AdsClientMojoBridge::GetClientInfo(const std::string& client_info,
+void AdsClientMojoBridge::GetClientInfo(const ads::ClientInfo& client_info,
                                      GetClientInfoCallback callback) {
-  ads::ClientInfo info;
-  info.FromJson(client_info);
+  ads::ClientInfo info(client_info);
   ads_client_->GetClientInfo(&info);
-  std::move(callback).Run(info.ToJson());
+  std::move(callback).Run(info);
 }
 
 void AdsClientMojoBridge::EventLog(const std::string& json) {
@@ -302,10 +299,9 @@ void AdsClientMojoBridge::LoadSampleBundle(
 }
 
 void AdsClientMojoBridge::ShowNotification(
-    const std::string& notification_info) {
-  auto info = std::make_unique<ads::NotificationInfo>();
-  if (info->FromJson(notification_info) == ads::Result::SUCCESS)
-    ads_client_->ShowNotification(std::move(info));
+    const ads::NotificationInfo& notification_info) {
+  ads_client_->ShowNotification(
+      std::make_unique<ads::NotificationInfo>(notification_info));
 }
 
 void AdsClientMojoBridge::SetCatalogIssuers(
@@ -316,10 +312,10 @@ void AdsClientMojoBridge::SetCatalogIssuers(
   }
 }
 
-void AdsClientMojoBridge::ConfirmAd(const std::string& notification_info) {
-  auto info = std::make_unique<ads::NotificationInfo>();
-  if (info->FromJson(notification_info) == ads::Result::SUCCESS)
-    ads_client_->ConfirmAd(std::move(info));
+void AdsClientMojoBridge::ConfirmAd(
+    const ads::NotificationInfo& notification_info) {
+  ads_client_->ConfirmAd(
+      std::make_unique<ads::NotificationInfo>(notification_info));
 }
 
 // static
@@ -331,22 +327,15 @@ void AdsClientMojoBridge::OnSaveBundleState(
   delete holder;
 }
 
-void AdsClientMojoBridge::SaveBundleState(const std::string& bundle_state_json,
-                       SaveBundleStateCallback callback) {
+void AdsClientMojoBridge::SaveBundleState(
+    const ads::BundleState& bundle_state,
+    SaveBundleStateCallback callback) {
   // this gets deleted in OnSaveBundleState
   auto* holder = new CallbackHolder<SaveBundleStateCallback>(
       AsWeakPtr(), std::move(callback));
-  auto bundle_state = std::make_unique<ads::BundleState>();
-
-  auto schema = ads_client_->LoadJsonSchema(ads::_bundle_schema_name);
-
-  if (bundle_state->FromJson(bundle_state_json, schema) ==
-      ads::Result::SUCCESS) {
-    ads_client_->SaveBundleState(std::move(bundle_state),
-        std::bind(AdsClientMojoBridge::OnSaveBundleState, holder, _1));
-  } else {
-    std::move(holder->get()).Run(ToMojomResult(ads::Result::FAILED));
-  }
+  ads_client_->SaveBundleState(
+      std::make_unique<ads::BundleState>(bundle_state),
+      std::bind(AdsClientMojoBridge::OnSaveBundleState, holder, _1));
 }
 
 // static
@@ -355,13 +344,8 @@ void AdsClientMojoBridge::OnGetAds(
     ads::Result result,
     const std::string& category,
     const std::vector<ads::AdInfo>& ad_info) {
-  if (holder->is_valid()) {
-    std::vector<std::string> ad_info_json;
-    for (const auto it : ad_info) {
-      ad_info_json.push_back(it.ToJson());
-    }
-    std::move(holder->get()).Run(ToMojomResult(result), category, ad_info_json);
-  }
+  if (holder->is_valid())
+    std::move(holder->get()).Run(ToMojomResult(result), category, ad_info);
   delete holder;
 }
 
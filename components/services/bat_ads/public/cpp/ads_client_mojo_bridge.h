@@ -50,9 +50,9 @@ class AdsClientMojoBridge : public mojom::BatAdsClient,
   bool LoadJsonSchema(const std::string& name, std::string* out_json) override;
   void LoadJsonSchema(const std::string& name,
                       LoadJsonSchemaCallback callback) override;
-  bool GetClientInfo(const std::string& client_info,
-                     std::string* out_client_info) override;
-  void GetClientInfo(const std::string& client_info,
+  bool GetClientInfo(const ads::ClientInfo& client_info,
+                     ads::ClientInfo* out_client_info) override;
+  void GetClientInfo(const ads::ClientInfo& client_info,
                      GetClientInfoCallback callback) override;
 
   void EventLog(const std::string& json) override;
@@ -72,10 +72,11 @@ class AdsClientMojoBridge : public mojom::BatAdsClient,
                   int32_t method,
                   URLRequestCallback callback) override;
   void LoadSampleBundle(LoadSampleBundleCallback callback) override;
-  void ShowNotification(const std::string& notification_info) override;
+  void ShowNotification(
+      const ads::NotificationInfo& notification_info) override;
   void SetCatalogIssuers(const std::string& issuers_info) override;
-  void ConfirmAd(const std::string& notification_info) override;
-  void SaveBundleState(const std::string& bundle_state,
+  void ConfirmAd(const ads::NotificationInfo& notification_info) override;
+  void SaveBundleState(const ads::BundleState& bundle_state,
                        SaveBundleStateCallback callback) override;
   void GetAds(const std::string& category,
               GetAdsCallback callback) override;
@@ -0,0 +1,75 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/public/cpp/bat_ads_struct_traits.h"
+
+#include "bat/ads/confirmation_type.h"
+
+namespace mojo {
+
+// static
+bool StructTraits<bat_ads::mojom::AdInfoDataView, ads::AdInfo>::Read(
+    bat_ads::mojom::AdInfoDataView in,
+    ads::AdInfo* out) {
+  if (!in.ReadCreativeSetId(&out->creative_set_id) ||
+      !in.ReadCampaignId(&out->campaign_id) ||
+      !in.ReadStartTimestamp(&out->start_timestamp) ||
+      !in.ReadEndTimestamp(&out->end_timestamp) ||
+      !in.ReadRegions(&out->regions) ||
+      !in.ReadAdvertiser(&out->advertiser) ||
+      !in.ReadNotificationText(&out->notification_text) ||
+      !in.ReadNotificationUrl(&out->notification_url) ||
+      !in.ReadUuid(&out->uuid)) {
+    return false;
+  }
+
+  out->daily_cap = in.daily_cap();
+  out->per_day = in.per_day();
+  out->total_max = in.total_max();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ads::mojom::NotificationInfoDataView,
+                  ads::NotificationInfo>::
+    Read(bat_ads::mojom::NotificationInfoDataView in,
+         ads::NotificationInfo* out) {
+  if (!in.ReadCreativeSetId(&out->creative_set_id) ||
+      !in.ReadCategory(&out->category) ||
+      !in.ReadAdvertiser(&out->advertiser) ||
+      !in.ReadText(&out->text) ||
+      !in.ReadUrl(&out->url) ||
+      !in.ReadUuid(&out->uuid)) {
+    return false;
+  }
+
+  out->type = static_cast<ads::ConfirmationType::Value>(in.type());
+  return true;
+}
+
+// static
+bool StructTraits<bat_ads::mojom::BundleStateDataView, ads::BundleState>::
+    Read(bat_ads::mojom::BundleStateDataView in, ads::BundleState* out) {
+  if (!in.ReadCatalogId(&out->catalog_id) ||
+      !in.ReadCategories(&out->categories)) {
+    return false;
+  }
+
+  out->catalog_version = in.catalog_version();
+  out->catalog_ping = in.catalog_ping();
+  out->catalog_last_updated_timestamp_in_seconds =
+      in.catalog_last_updated_timestamp_in_seconds();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ads::mojom::ClientInfoDataView, ads::ClientInfo>::Read(
+    bat_ads::mojom::ClientInfoDataView in,
+    ads::ClientInfo* out) {
+  out->platform = static_cast<ads::ClientInfoPlatformType>(in.platform());
+  return true;
+}
+
+}  // namespace mojo
@@ -0,0 +1,150 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_BAT_ADS_STRUCT_TRAITS_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_BAT_ADS_STRUCT_TRAITS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bat/ads/ad_info.h"
+#include "bat/ads/bundle_state.h"
+#include "bat/ads/client_info.h"
+#include "bat/ads/notification_info.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+
+namespace mojo {
+
+template <>
+struct StructTraits<bat_ads::mojom::AdInfoDataView, ads::AdInfo> {
+  static const std::string& creative_set_id(const ads::AdInfo& info) {
+    return info.creative_set_id;
+  }
+
+  static const std::string& campaign_id(const ads::AdInfo& info) {
+    return info.campaign_id;
+  }
+
+  static const std::string& start_timestamp(const ads::AdInfo& info) {
+    return info.start_timestamp;
+  }
+
+  static const std::string& end_timestamp(const ads::AdInfo& info) {
+    return info.end_timestamp;
+  }
+
+  static uint32_t daily_cap(const ads::AdInfo& info) {
+    return info.daily_cap;
+  }
+
+  static uint32_t per_day(const ads::AdInfo& info) {
+    return info.per_day;
+  }
+
+  static uint32_t total_max(const ads::AdInfo& info) {
+    return info.total_max;
+  }
+
+  static const std::vector<std::string>& regions(const ads::AdInfo& info) {
+    return info.regions;
+  }
+
+  static const std::string& advertiser(const ads::AdInfo& info) {
+    return info.advertiser;
+  }
+
+  static const std::string& notification_text(const ads::AdInfo& info) {
+    return info.notification_text;
+  }
+
+  static const std::string& notification_url(const ads::AdInfo& info) {
+    return info.notification_url;
+  }
+
+  static const std::string& uuid(const ads::AdInfo& info) {
+    return info.uuid;
+  }
+
+  static bool Read(bat_ads::mojom::AdInfoDataView in, ads::AdInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ads::mojom::NotificationInfoDataView,
+                    ads::NotificationInfo> {
+  static const std::string& creative_set_id(
+      const ads::NotificationInfo& info) {
+    return info.creative_set_id;
+  }
+
+  static const std::string& category(const ads::NotificationInfo& info) {
+    return info.category;
+  }
+
+  static const std::string& advertiser(const ads::NotificationInfo& info) {
+    return info.advertiser;
+  }
+
+  static const std::string& text(const ads::NotificationInfo& info) {
+    return info.text;
+  }
+
+  static const std::string& url(const ads::NotificationInfo& info) {
+    return info.url;
+  }
+
+  static const std::string& uuid(const ads::NotificationInfo& info) {
+    return info.uuid;
+  }
+
+  static int32_t type(const ads::NotificationInfo& info) {
+    return info.type.value();
+  }
+
+  static bool Read(bat_ads::mojom::NotificationInfoDataView in,
+                   ads::NotificationInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ads::mojom::BundleStateDataView, ads::BundleState> {
+  static const std::string& catalog_id(const ads::BundleState& state) {
+    return state.catalog_id;
+  }
+
+  static uint64_t catalog_version(const ads::BundleState& state) {
+    return state.catalog_version;
+  }
+
+  static uint64_t catalog_ping(const ads::BundleState& state) {
+    return state.catalog_ping;
+  }
+
+  static uint64_t catalog_last_updated_timestamp_in_seconds(
+      const ads::BundleState& state) {
+    return state.catalog_last_updated_timestamp_in_seconds;
+  }
+
+  static const std::map<std::string, std::vector<ads::AdInfo>>& categories(
+      const ads::BundleState& state) {
+    return state.categories;
+  }
+
+  static bool Read(bat_ads::mojom::BundleStateDataView in,
+                   ads::BundleState* out);
+};
+
+template <>
+struct StructTraits<bat_ads::mojom::ClientInfoDataView, ads::ClientInfo> {
+  static int32_t platform(const ads::ClientInfo& info) {
+    return info.platform;
+  }
+
+  static bool Read(bat_ads::mojom::ClientInfoDataView in,
+                   ads::ClientInfo* out);
+};
+
+}  // namespace mojo
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_BAT_ADS_STRUCT_TRAITS_H_
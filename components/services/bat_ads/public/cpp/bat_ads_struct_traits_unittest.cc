@@ -0,0 +1,138 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/public/cpp/bat_ads_struct_traits.h"
+
+#include <string>
+
+#include "mojo/public/cpp/test_support/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAdsStructTraitsTest.*
+
+namespace bat_ads {
+
+namespace {
+
+ads::AdInfo CreateAdInfo(const std::string& uuid) {
+  ads::AdInfo ad_info;
+  ad_info.creative_set_id = "creative_set_" + uuid;
+  ad_info.campaign_id = "campaign";
+  ad_info.start_timestamp = "2019-01-01T00:00:00Z";
+  ad_info.end_timestamp = "2099-01-01T00:00:00Z";
+  ad_info.daily_cap = 1;
+  ad_info.per_day = 2;
+  ad_info.total_max = 3;
+  ad_info.regions = {"US", "GB"};
+  ad_info.advertiser = "advertiser";
+  ad_info.notification_text = "text";
+  ad_info.notification_url = "https://brave.com";
+  ad_info.uuid = uuid;
+  return ad_info;
+}
+
+void ExpectAdInfoEq(const ads::AdInfo& expected, const ads::AdInfo& actual) {
+  EXPECT_EQ(expected.creative_set_id, actual.creative_set_id);
+  EXPECT_EQ(expected.campaign_id, actual.campaign_id);
+  EXPECT_EQ(expected.start_timestamp, actual.start_timestamp);
+  EXPECT_EQ(expected.end_timestamp, actual.end_timestamp);
+  EXPECT_EQ(expected.daily_cap, actual.daily_cap);
+  EXPECT_EQ(expected.per_day, actual.per_day);
+  EXPECT_EQ(expected.total_max, actual.total_max);
+  EXPECT_EQ(expected.regions, actual.regions);
+  EXPECT_EQ(expected.advertiser, actual.advertiser);
+  EXPECT_EQ(expected.notification_text, actual.notification_text);
+  EXPECT_EQ(expected.notification_url, actual.notification_url);
+  EXPECT_EQ(expected.uuid, actual.uuid);
+}
+
+}  // namespace
+
+TEST(BatAdsStructTraitsTest, AdInfo) {
+  // Arrange
+  auto input = CreateAdInfo("a");
+
+  // Act
+  ads::AdInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::AdInfo>(
+      &input, &output));
+
+  // Assert
+  ExpectAdInfoEq(input, output);
+}
+
+TEST(BatAdsStructTraitsTest, NotificationInfo) {
+  // Arrange
+  ads::NotificationInfo input;
+  input.creative_set_id = "creative_set";
+  input.category = "technology";
+  input.advertiser = "advertiser";
+  input.text = "text";
+  input.url = "https://brave.com";
+  input.uuid = "uuid";
+  input.type = ads::ConfirmationType::LANDED;
+
+  // Act
+  ads::NotificationInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::NotificationInfo>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.creative_set_id, output.creative_set_id);
+  EXPECT_EQ(input.category, output.category);
+  EXPECT_EQ(input.advertiser, output.advertiser);
+  EXPECT_EQ(input.text, output.text);
+  EXPECT_EQ(input.url, output.url);
+  EXPECT_EQ(input.uuid, output.uuid);
+  EXPECT_EQ(input.type, output.type);
+}
+
+TEST(BatAdsStructTraitsTest, BundleState) {
+  // Arrange
+  ads::BundleState input;
+  input.catalog_id = "catalog";
+  input.catalog_version = 2;
+  input.catalog_ping = 7200000;
+  input.catalog_last_updated_timestamp_in_seconds = 1550000000;
+  input.categories["technology"] = {CreateAdInfo("a"), CreateAdInfo("b")};
+  input.categories["travel"] = {CreateAdInfo("c")};
+
+  // Act
+  ads::BundleState output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::BundleState>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.catalog_id, output.catalog_id);
+  EXPECT_EQ(input.catalog_version, output.catalog_version);
+  EXPECT_EQ(input.catalog_ping, output.catalog_ping);
+  EXPECT_EQ(input.catalog_last_updated_timestamp_in_seconds,
+            output.catalog_last_updated_timestamp_in_seconds);
+  ASSERT_EQ(input.categories.size(), output.categories.size());
+  for (const auto& category : input.categories) {
+    const auto it = output.categories.find(category.first);
+    ASSERT_NE(output.categories.end(), it);
+    ASSERT_EQ(category.second.size(), it->second.size());
+    for (size_t i = 0; i < category.second.size(); i++) {
+      ExpectAdInfoEq(category.second.at(i), it->second.at(i));
+    }
+  }
+}
+
+TEST(BatAdsStructTraitsTest, ClientInfo) {
+  // Arrange
+  ads::ClientInfo input;
+  input.platform = ads::ClientInfoPlatformType::LINUX;
+
+  // Act
+  ads::ClientInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::ClientInfo>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.platform, output.platform);
+}
+
+}  // namespace bat_ads
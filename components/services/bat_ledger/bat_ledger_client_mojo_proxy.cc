@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/optional.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 namespace bat_ledger {
@@ -33,6 +34,24 @@ int32_t ToMojomMethod(ledger::URL_METHOD method) {
   return (int32_t)method;
 }
 
+std::unique_ptr<ledger::PublisherInfo> ToLedgerPublisherInfo(
+    const base::Optional<ledger::PublisherInfo>& info) {
+  if (!info) {
+    return nullptr;
+  }
+
+  return std::make_unique<ledger::PublisherInfo>(*info);
+}
+
+base::Optional<ledger::PublisherInfo> ToMojomPublisherInfo(
+    const std::unique_ptr<ledger::PublisherInfo>& info) {
+  if (!info) {
+    return base::nullopt;
+  }
+
+  return *info;
+}
+
 class LogStreamImpl : public ledger::LogStream {
  public:
   LogStreamImpl(const char* file,
@@ -99,7 +118,8 @@ void OnExcludedNumberDB(
 }  // namespace
 
 BatLedgerClientMojoProxy::BatLedgerClientMojoProxy(
-    mojom::BatLedgerClientAssociatedPtrInfo client_info) {
+    mojom::BatLedgerClientAssociatedPtrInfo client_info)
+    : defer_states_(false) {
   bat_ledger_client_.Bind(std::move(client_info));
 }
 
@@ -251,8 +271,9 @@ void BatLedgerClientMojoProxy::LoadPublisherState(
 
 void BatLedgerClientMojoProxy::OnLoadPublisherList(
     ledger::LedgerCallbackHandler* handler,
-    int32_t result, const std::string& data) {
-  handler->OnPublisherListLoaded(ToLedgerResult(result), data);
+    int32_t result, const std::vector<uint8_t>& data) {
+  handler->OnPublisherListLoaded(ToLedgerResult(result),
+      std::string(data.begin(), data.end()));
 }
 
 void BatLedgerClientMojoProxy::LoadPublisherList(
@@ -285,6 +306,18 @@ void BatLedgerClientMojoProxy::SaveLedgerState(
         AsWeakPtr(), base::Unretained(handler)));
 }
 
+void BatLedgerClientMojoProxy::AppendLedgerState(
+    const std::string& ledger_state, ledger::LedgerCallbackHandler* handler) {
+  if (!Connected()) {
+    handler->OnLedgerStateSaved(ledger::Result::LEDGER_ERROR);
+    return;
+  }
+
+  bat_ledger_client_->AppendLedgerState(ledger_state,
+      base::BindOnce(&BatLedgerClientMojoProxy::OnSaveLedgerState,
+        AsWeakPtr(), base::Unretained(handler)));
+}
+
 void BatLedgerClientMojoProxy::OnSavePublisherState(
     ledger::LedgerCallbackHandler* handler,
     int32_t result) {
@@ -318,43 +351,50 @@ void BatLedgerClientMojoProxy::SavePublishersList(
     return;
   }
 
-  bat_ledger_client_->SavePublishersList(publishers_list,
+  bat_ledger_client_->SavePublishersList(
+      std::vector<uint8_t>(publishers_list.begin(), publishers_list.end()),
       base::BindOnce(&BatLedgerClientMojoProxy::OnSavePublishersList,
         AsWeakPtr(), base::Unretained(handler)));
 }
 
-void OnSavePublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
+void BatLedgerClientMojoProxy::AppendPublishersListDelta(
+    const std::string& publishers_list_delta,
+    ledger::LedgerCallbackHandler* handler) {
+  if (!Connected()) {
+    handler->OnPublishersListSaved(ledger::Result::LEDGER_ERROR);
+    return;
   }
-  callback(ToLedgerResult(result), std::move(info));
+
+  bat_ledger_client_->AppendPublishersListDelta(
+      std::vector<uint8_t>(publishers_list_delta.begin(),
+                           publishers_list_delta.end()),
+      base::BindOnce(&BatLedgerClientMojoProxy::OnSavePublishersList,
+        AsWeakPtr(), base::Unretained(handler)));
+}
+
+void OnSavePublisherInfo(const ledger::PublisherInfoCallback& callback,
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::SavePublisherInfo(
     std::unique_ptr<ledger::PublisherInfo> publisher_info,
     ledger::PublisherInfoCallback callback) {
-  if (!Connected()) {
+  if (!Connected() || !publisher_info) {
     callback(ledger::Result::LEDGER_ERROR,
         std::unique_ptr<ledger::PublisherInfo>());
     return;
   }
 
-  std::string json_info = publisher_info ? publisher_info->ToJson() : "";
-  bat_ledger_client_->SavePublisherInfo(json_info,
+  bat_ledger_client_->SavePublisherInfo(*publisher_info,
       base::BindOnce(&OnSavePublisherInfo, std::move(callback)));
 }
 
 void OnLoadPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadPublisherInfo(
@@ -371,15 +411,9 @@ void BatLedgerClientMojoProxy::LoadPublisherInfo(
 }
 
 void OnLoadPanelPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadPanelPublisherInfo(
@@ -391,18 +425,14 @@ void BatLedgerClientMojoProxy::LoadPanelPublisherInfo(
     return;
   }
 
-  bat_ledger_client_->LoadPanelPublisherInfo(filter.ToJson(),
+  bat_ledger_client_->LoadPanelPublisherInfo(filter,
       base::BindOnce(&OnLoadPanelPublisherInfo, std::move(callback)));
 }
 
 void OnLoadMediaPublisherInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadMediaPublisherInfo(
@@ -452,9 +482,8 @@ void BatLedgerClientMojoProxy::OnPanelPublisherInfo(ledger::Result result,
     return;
   }
 
-  std::string json_info = info ? info->ToJson() : "";
   bat_ledger_client_->OnPanelPublisherInfo(ToMojomResult(result),
-      json_info, windowId);
+      ToMojomPublisherInfo(info), windowId);
 }
 
 void OnFetchFavIcon(const ledger::FetchIconCallback& callback,
@@ -475,17 +504,9 @@ void BatLedgerClientMojoProxy::FetchFavIcon(const std::string& url,
 }
 
 void OnGetRecurringTips(const ledger::PublisherInfoListCallback& callback,
-                        const std::vector<std::string>& publisher_info_list,
+                        const ledger::PublisherInfoList& publisher_info_list,
                         uint32_t next_record) {
-  ledger::PublisherInfoList list;
-
-  for (const auto& publisher_info : publisher_info_list) {
-    ledger::PublisherInfo info;
-    info.loadFromJson(publisher_info);
-    list.push_back(info);
-  }
-
-  callback(list, next_record);
+  callback(publisher_info_list, next_record);
 }
 
 void BatLedgerClientMojoProxy::GetRecurringTips(
@@ -500,17 +521,9 @@ void BatLedgerClientMojoProxy::GetRecurringTips(
 }
 
 void OnGetOneTimeTips(const ledger::PublisherInfoListCallback& callback,
-                      const std::vector<std::string>& publisher_info_list,
+                      const ledger::PublisherInfoList& publisher_info_list,
                       uint32_t next_record) {
-  ledger::PublisherInfoList list;
-
-  for (const auto& publisher_info : publisher_info_list) {
-    ledger::PublisherInfo info;
-    info.loadFromJson(publisher_info);
-    list.push_back(info);
-  }
-
-  callback(list, next_record);
+  callback(publisher_info_list, next_record);
 }
 
 void BatLedgerClientMojoProxy::GetOneTimeTips(
@@ -613,13 +626,9 @@ void BatLedgerClientMojoProxy::SavePendingContribution(
 }
 
 void OnLoadActivityInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::LoadActivityInfo(
@@ -631,31 +640,26 @@ void BatLedgerClientMojoProxy::LoadActivityInfo(
     return;
   }
 
-  bat_ledger_client_->LoadActivityInfo(filter.ToJson(),
+  bat_ledger_client_->LoadActivityInfo(filter,
       base::BindOnce(&OnLoadActivityInfo, std::move(callback)));
 }
 
 void OnSaveActivityInfo(const ledger::PublisherInfoCallback& callback,
-    int32_t result, const std::string& publisher_info) {
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-  callback(ToLedgerResult(result), std::move(info));
+    int32_t result,
+    const base::Optional<ledger::PublisherInfo>& publisher_info) {
+  callback(ToLedgerResult(result), ToLedgerPublisherInfo(publisher_info));
 }
 
 void BatLedgerClientMojoProxy::SaveActivityInfo(
     std::unique_ptr<ledger::PublisherInfo> publisher_info,
     ledger::PublisherInfoCallback callback) {
-  if (!Connected()) {
+  if (!Connected() || !publisher_info) {
     callback(ledger::Result::LEDGER_ERROR,
         std::unique_ptr<ledger::PublisherInfo>());
     return;
   }
 
-  std::string json_info = publisher_info ? publisher_info->ToJson() : "";
-  bat_ledger_client_->SaveActivityInfo(json_info,
+  bat_ledger_client_->SaveActivityInfo(*publisher_info,
       base::BindOnce(&OnSaveActivityInfo, std::move(callback)));
 }
 
@@ -676,17 +680,9 @@ void BatLedgerClientMojoProxy::OnRestorePublishers(
 }
 
 void OnGetActivityInfoList(const ledger::PublisherInfoListCallback& callback,
-    const std::vector<std::string>& publisher_info_list,
+    const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  ledger::PublisherInfoList list;
-
-  for (const auto& publisher_info : publisher_info_list) {
-    ledger::PublisherInfo info;
-    info.loadFromJson(publisher_info);
-    list.push_back(info);
-  }
-
-  callback(list, next_record);
+  callback(publisher_info_list, next_record);
 }
 
 void BatLedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
@@ -700,7 +696,7 @@ void BatLedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
 
   bat_ledger_client_->GetActivityInfoList(start,
       limit,
-      filter.ToJson(),
+      filter,
       base::BindOnce(&OnGetActivityInfoList, std::move(callback)));
 }
 
@@ -711,13 +707,19 @@ void BatLedgerClientMojoProxy::SaveNormalizedPublisherList(
     return;
   }
 
-  bat_ledger_client_->SaveNormalizedPublisherList(normalized_list.ToJson());
+  bat_ledger_client_->SaveNormalizedPublisherList(normalized_list.list);
 }
 
 void BatLedgerClientMojoProxy::SaveState(
     const std::string& name,
     const std::string& value,
     ledger::OnSaveCallback callback) {
+  if (defer_states_) {
+    deferred_states_[name] = value;
+    callback(ledger::Result::LEDGER_OK);
+    return;
+  }
+
   if (!Connected()) {
     callback(ledger::Result::LEDGER_ERROR);
     return;
@@ -766,6 +768,15 @@ void BatLedgerClientMojoProxy::ConfirmationsTransactionHistoryDidChange() {
   bat_ledger_client_->ConfirmationsTransactionHistoryDidChange();
 }
 
+void BatLedgerClientMojoProxy::DeferStates() {
+  defer_states_ = true;
+}
+
+std::map<std::string, std::string>
+BatLedgerClientMojoProxy::TakeDeferredStates() {
+  return std::move(deferred_states_);
+}
+
 bool BatLedgerClientMojoProxy::Connected() const {
   return bat_ledger_client_.is_bound();
 }
@@ -48,6 +48,8 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
   void LoadPublisherState(ledger::LedgerCallbackHandler* handler) override;
   void SaveLedgerState(const std::string& ledger_state,
                        ledger::LedgerCallbackHandler* handler) override;
+  void AppendLedgerState(const std::string& ledger_state,
+                         ledger::LedgerCallbackHandler* handler) override;
   void SavePublisherState(const std::string& publisher_state,
                           ledger::LedgerCallbackHandler* handler) override;
 
@@ -59,6 +61,8 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
                               ledger::PublisherInfoCallback callback) override;
   void SavePublishersList(const std::string& publishers_list,
                           ledger::LedgerCallbackHandler* handler) override;
+  void AppendPublishersListDelta(const std::string& publishers_list_delta,
+                                 ledger::LedgerCallbackHandler* handler) override;
   void SetTimer(uint64_t time_offset, uint32_t* timer_id) override;
   void KillTimer(const uint32_t timer_id) override;
   void LoadPublisherList(ledger::LedgerCallbackHandler* handler) override;
@@ -140,6 +144,11 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
   void GetExcludedPublishersNumberDB(
       ledger::GetExcludedPublishersNumberDBCallback callback) override;
 
+  // Keeps anything saved through SaveState from now on for
+  // TakeDeferredStates() instead of sending it through the client
+  void DeferStates();
+  std::map<std::string, std::string> TakeDeferredStates();
+
  private:
   bool Connected() const;
 
@@ -149,12 +158,15 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
 
   mojom::BatLedgerClientAssociatedPtr bat_ledger_client_;
 
+  bool defer_states_;
+  std::map<std::string, std::string> deferred_states_;
+
   void OnLoadLedgerState(ledger::LedgerCallbackHandler* handler,
       int32_t result, const std::string& data);
   void OnLoadPublisherState(ledger::LedgerCallbackHandler* handler,
       int32_t result, const std::string& data);
   void OnLoadPublisherList(ledger::LedgerCallbackHandler* handler,
-      int32_t result, const std::string& data);
+      int32_t result, const std::vector<uint8_t>& data);
   void OnSaveLedgerState(ledger::LedgerCallbackHandler* handler,
       int32_t result);
   void OnSavePublisherState(ledger::LedgerCallbackHandler* handler,
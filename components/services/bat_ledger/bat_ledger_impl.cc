@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/components/services/bat_ledger/bat_ledger_client_mojo_proxy.h"
 #include "mojo/public/cpp/bindings/map.h"
 
@@ -54,6 +55,30 @@ void BatLedgerImpl::Initialize() {
   ledger_->Initialize();
 }
 
+// static
+void BatLedgerImpl::OnShutdown(
+    CallbackHolder<ShutdownCallback>* holder,
+    BatLedgerClientMojoProxy* client,
+    ledger::Result result) {
+  // |client| is owned by the BatLedgerImpl that |holder| checks for
+  if (holder->is_valid())
+    std::move(holder->get()).Run(mojo::MapToFlatMap(
+        client->TakeDeferredStates()));
+  delete holder;
+}
+
+void BatLedgerImpl::Shutdown(ShutdownCallback callback) {
+  // The browser closes the client as soon as it asks to shut down, so the
+  // pending state is answered with instead
+  bat_ledger_client_mojo_proxy_->DeferStates();
+
+  // delete in OnShutdown
+  auto* holder = new CallbackHolder<ShutdownCallback>(
+      AsWeakPtr(), std::move(callback));
+  ledger_->Shutdown(std::bind(BatLedgerImpl::OnShutdown, holder,
+      bat_ledger_client_mojo_proxy_.get(), _1));
+}
+
 void BatLedgerImpl::CreateWallet() {
   ledger_->CreateWallet();
 }
@@ -114,11 +139,9 @@ void BatLedgerImpl::GetReconcileStamp(GetReconcileStampCallback callback) {
   std::move(callback).Run(ledger_->GetReconcileStamp());
 }
 
-void BatLedgerImpl::OnLoad(const std::string& visit_data,
+void BatLedgerImpl::OnLoad(const ledger::VisitData& visit_data,
     uint64_t current_time) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnLoad(visitData, current_time);
+  ledger_->OnLoad(visit_data, current_time);
 }
 
 void BatLedgerImpl::OnUnload(uint32_t tab_id, uint64_t current_time) {
@@ -151,20 +174,16 @@ void BatLedgerImpl::OnMediaStop(uint32_t tab_id, uint64_t current_time) {
 
 void BatLedgerImpl::OnPostData(const std::string& url,
     const std::string& first_party_url, const std::string& referrer,
-    const std::string& post_data, const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnPostData(url, first_party_url, referrer, post_data, visitData);
+    const std::string& post_data, const ledger::VisitData& visit_data) {
+  ledger_->OnPostData(url, first_party_url, referrer, post_data, visit_data);
 }
 
 void BatLedgerImpl::OnXHRLoad(uint32_t tab_id, const std::string& url,
     const base::flat_map<std::string, std::string>& parts,
     const std::string& first_party_url, const std::string& referrer,
-    const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnXHRLoad(tab_id, url, mojo::FlatMapToMap(parts),
-        first_party_url, referrer, visitData);
+    const ledger::VisitData& visit_data) {
+  ledger_->OnXHRLoad(tab_id, url, mojo::FlatMapToMap(parts),
+      first_party_url, referrer, visit_data);
 }
 
 void BatLedgerImpl::SetPublisherExclude(const std::string& publisher_key,
@@ -313,11 +332,9 @@ void BatLedgerImpl::IsWalletCreated(IsWalletCreatedCallback callback) {
 
 void BatLedgerImpl::GetPublisherActivityFromUrl(
     uint64_t window_id,
-    const std::string& visit_data,
+    const ledger::VisitData& visit_data,
     const std::string& publisher_blob) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->GetPublisherActivityFromUrl(window_id, visitData, publisher_blob);
+  ledger_->GetPublisherActivityFromUrl(window_id, visit_data, publisher_blob);
 }
 
 // static
@@ -344,12 +361,11 @@ void BatLedgerImpl::GetContributionAmount(
   std::move(callback).Run(ledger_->GetContributionAmount());
 }
 
-void BatLedgerImpl::DoDirectDonation(const std::string& publisher_info,
-                                     int32_t amount,
-                                     const std::string& currency) {
-  ledger::PublisherInfo info;
-  if (info.loadFromJson(publisher_info))
-    ledger_->DoDirectDonation(info, amount, currency);
+void BatLedgerImpl::DoDirectDonation(
+    const ledger::PublisherInfo& publisher_info,
+    int32_t amount,
+    const std::string& currency) {
+  ledger_->DoDirectDonation(publisher_info, amount, currency);
 }
 
 void BatLedgerImpl::RemoveRecurringTip(const std::string& publisher_key) {
@@ -429,14 +445,8 @@ void BatLedgerImpl::OnGetRecurringTips(
     CallbackHolder<GetRecurringTipsCallback>* holder,
     const ledger::PublisherInfoList& list,
     uint32_t num) {
-
-  std::vector<std::string> json_list;
-  for (auto const& item : list) {
-    json_list.push_back(item.ToJson());
-  }
-
   if (holder->is_valid()) {
-    std::move(holder->get()).Run(json_list);
+    std::move(holder->get()).Run(list);
   }
   delete holder;
 }
@@ -454,14 +464,8 @@ void BatLedgerImpl::OnGetOneTimeTips(
     CallbackHolder<GetRecurringTipsCallback>* holder,
     const ledger::PublisherInfoList& list,
     uint32_t num) {
-
-  std::vector<std::string> json_list;
-  for (auto const& item : list) {
-    json_list.push_back(item.ToJson());
-  }
-
   if (holder->is_valid()) {
-    std::move(holder->get()).Run(json_list);
+    std::move(holder->get()).Run(list);
   }
   delete holder;
 }
@@ -479,13 +483,8 @@ void BatLedgerImpl::OnGetActivityInfoList(
     CallbackHolder<GetActivityInfoListCallback>* holder,
     const ledger::PublisherInfoList& list,
     uint32_t num) {
-  std::vector<std::string> json_list;
-  for (auto const& item : list) {
-    json_list.push_back(item.ToJson());
-  }
-
   if (holder->is_valid()) {
-    std::move(holder->get()).Run(json_list, num);
+    std::move(holder->get()).Run(list, num);
   }
 
   delete holder;
@@ -494,19 +493,16 @@ void BatLedgerImpl::OnGetActivityInfoList(
 void BatLedgerImpl::GetActivityInfoList(
     uint32_t start,
     uint32_t limit,
-    const std::string& json_filter,
+    const ledger::ActivityInfoFilter& filter,
     GetActivityInfoListCallback callback) {
   auto* holder = new CallbackHolder<GetActivityInfoListCallback>(
       AsWeakPtr(), std::move(callback));
 
-  ledger::ActivityInfoFilter filter;
-  if (filter.loadFromJson(json_filter)) {
-    ledger_->GetActivityInfoList(
-        start,
-        limit,
-        filter,
-        std::bind(BatLedgerImpl::OnGetActivityInfoList, holder, _1, _2));
-  }
+  ledger_->GetActivityInfoList(
+      start,
+      limit,
+      filter,
+      std::bind(BatLedgerImpl::OnGetActivityInfoList, holder, _1, _2));
 }
 
 // static
@@ -514,9 +510,9 @@ void BatLedgerImpl::OnLoadPublisherInfo(
     CallbackHolder<LoadPublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string publisher;
+  base::Optional<ledger::PublisherInfo> publisher;
   if (info) {
-    publisher = info->ToJson();
+    publisher = *info;
   }
 
   if (holder->is_valid()) {
@@ -0,0 +1,139 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
+
+#include <utility>
+
+namespace mojo {
+
+namespace {
+
+// The ledger enums cross the pipe as plain integers, so values that don't
+// name an enumerator are rejected rather than cast.
+
+bool IsValidPublisherExclude(int32_t value) {
+  return value >= ledger::PUBLISHER_EXCLUDE::ALL &&
+         value <= ledger::PUBLISHER_EXCLUDE::INCLUDED;
+}
+
+// A category may be a combination of categories.
+bool IsValidRewardsCategory(int32_t value) {
+  return value >= 0 &&
+         (value & ~ledger::REWARDS_CATEGORY::ALL_CATEGORIES) == 0;
+}
+
+bool IsValidExcludeFilter(int32_t value) {
+  return value >= ledger::EXCLUDE_FILTER::FILTER_ALL &&
+         value <= ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED;
+}
+
+}  // namespace
+
+// static
+bool StructTraits<bat_ledger::mojom::VisitDataDataView, ledger::VisitData>::
+    Read(bat_ledger::mojom::VisitDataDataView in, ledger::VisitData* out) {
+  if (!in.ReadTld(&out->tld) ||
+      !in.ReadDomain(&out->domain) ||
+      !in.ReadPath(&out->path) ||
+      !in.ReadName(&out->name) ||
+      !in.ReadUrl(&out->url) ||
+      !in.ReadProvider(&out->provider) ||
+      !in.ReadFaviconUrl(&out->favicon_url)) {
+    return false;
+  }
+
+  out->tab_id = in.tab_id();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::ContributionInfoDataView,
+                  ledger::ContributionInfo>::
+    Read(bat_ledger::mojom::ContributionInfoDataView in,
+         ledger::ContributionInfo* out) {
+  if (!in.ReadPublisher(&out->publisher)) {
+    return false;
+  }
+
+  out->value = in.value();
+  out->date = in.date();
+  return true;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::PublisherInfoDataView,
+                  ledger::PublisherInfo>::
+    Read(bat_ledger::mojom::PublisherInfoDataView in,
+         ledger::PublisherInfo* out) {
+  if (!in.ReadId(&out->id) ||
+      !in.ReadName(&out->name) ||
+      !in.ReadUrl(&out->url) ||
+      !in.ReadProvider(&out->provider) ||
+      !in.ReadFaviconUrl(&out->favicon_url) ||
+      !in.ReadContributions(&out->contributions)) {
+    return false;
+  }
+
+  if (!IsValidPublisherExclude(in.excluded()) ||
+      !IsValidRewardsCategory(in.category())) {
+    return false;
+  }
+
+  out->duration = in.duration();
+  out->score = in.score();
+  out->visits = in.visits();
+  out->percent = in.percent();
+  out->weight = in.weight();
+  out->excluded = static_cast<ledger::PUBLISHER_EXCLUDE>(in.excluded());
+  out->category = static_cast<ledger::REWARDS_CATEGORY>(in.category());
+  out->reconcile_stamp = in.reconcile_stamp();
+  out->verified = in.verified();
+  return true;
+}
+
+// static
+std::vector<bat_ledger::mojom::ActivityInfoFilterOrderPairPtr>
+StructTraits<bat_ledger::mojom::ActivityInfoFilterDataView,
+             ledger::ActivityInfoFilter>::
+    order_by(const ledger::ActivityInfoFilter& filter) {
+  std::vector<bat_ledger::mojom::ActivityInfoFilterOrderPairPtr> order_by;
+  for (const auto& pair : filter.order_by) {
+    order_by.push_back(bat_ledger::mojom::ActivityInfoFilterOrderPair::New(
+        pair.first, pair.second));
+  }
+  return order_by;
+}
+
+// static
+bool StructTraits<bat_ledger::mojom::ActivityInfoFilterDataView,
+                  ledger::ActivityInfoFilter>::
+    Read(bat_ledger::mojom::ActivityInfoFilterDataView in,
+         ledger::ActivityInfoFilter* out) {
+  std::vector<bat_ledger::mojom::ActivityInfoFilterOrderPairPtr> order_by;
+  if (!in.ReadId(&out->id) || !in.ReadOrderBy(&order_by)) {
+    return false;
+  }
+
+  if (!IsValidExcludeFilter(in.excluded())) {
+    return false;
+  }
+
+  out->order_by.clear();
+  for (auto& pair : order_by) {
+    out->order_by.push_back(
+        std::make_pair(std::move(pair->property_name), pair->ascending));
+  }
+
+  out->excluded = static_cast<ledger::EXCLUDE_FILTER>(in.excluded());
+  out->percent = in.percent();
+  out->min_duration = in.min_duration();
+  out->reconcile_stamp = in.reconcile_stamp();
+  out->non_verified = in.non_verified();
+  out->min_visits = in.min_visits();
+  return true;
+}
+
+}  // namespace mojo
@@ -0,0 +1,183 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
+
+#include <string>
+#include <vector>
+
+#include "bat/ledger/ledger.h"
+#include "bat/ledger/publisher_info.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
+
+namespace mojo {
+
+template <>
+struct StructTraits<bat_ledger::mojom::VisitDataDataView, ledger::VisitData> {
+  static const std::string& tld(const ledger::VisitData& data) {
+    return data.tld;
+  }
+
+  static const std::string& domain(const ledger::VisitData& data) {
+    return data.domain;
+  }
+
+  static const std::string& path(const ledger::VisitData& data) {
+    return data.path;
+  }
+
+  static uint32_t tab_id(const ledger::VisitData& data) {
+    return data.tab_id;
+  }
+
+  static const std::string& name(const ledger::VisitData& data) {
+    return data.name;
+  }
+
+  static const std::string& url(const ledger::VisitData& data) {
+    return data.url;
+  }
+
+  static const std::string& provider(const ledger::VisitData& data) {
+    return data.provider;
+  }
+
+  static const std::string& favicon_url(const ledger::VisitData& data) {
+    return data.favicon_url;
+  }
+
+  static bool Read(bat_ledger::mojom::VisitDataDataView in,
+                   ledger::VisitData* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::ContributionInfoDataView,
+                    ledger::ContributionInfo> {
+  static const std::string& publisher(const ledger::ContributionInfo& info) {
+    return info.publisher;
+  }
+
+  static double value(const ledger::ContributionInfo& info) {
+    return info.value;
+  }
+
+  static uint64_t date(const ledger::ContributionInfo& info) {
+    return info.date;
+  }
+
+  static bool Read(bat_ledger::mojom::ContributionInfoDataView in,
+                   ledger::ContributionInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::PublisherInfoDataView,
+                    ledger::PublisherInfo> {
+  static const std::string& id(const ledger::PublisherInfo& info) {
+    return info.id;
+  }
+
+  static uint64_t duration(const ledger::PublisherInfo& info) {
+    return info.duration;
+  }
+
+  static double score(const ledger::PublisherInfo& info) {
+    return info.score;
+  }
+
+  static uint32_t visits(const ledger::PublisherInfo& info) {
+    return info.visits;
+  }
+
+  static uint32_t percent(const ledger::PublisherInfo& info) {
+    return info.percent;
+  }
+
+  static double weight(const ledger::PublisherInfo& info) {
+    return info.weight;
+  }
+
+  static int32_t excluded(const ledger::PublisherInfo& info) {
+    return info.excluded;
+  }
+
+  static int32_t category(const ledger::PublisherInfo& info) {
+    return info.category;
+  }
+
+  static uint64_t reconcile_stamp(const ledger::PublisherInfo& info) {
+    return info.reconcile_stamp;
+  }
+
+  static bool verified(const ledger::PublisherInfo& info) {
+    return info.verified;
+  }
+
+  static const std::string& name(const ledger::PublisherInfo& info) {
+    return info.name;
+  }
+
+  static const std::string& url(const ledger::PublisherInfo& info) {
+    return info.url;
+  }
+
+  static const std::string& provider(const ledger::PublisherInfo& info) {
+    return info.provider;
+  }
+
+  static const std::string& favicon_url(const ledger::PublisherInfo& info) {
+    return info.favicon_url;
+  }
+
+  static const std::vector<ledger::ContributionInfo>& contributions(
+      const ledger::PublisherInfo& info) {
+    return info.contributions;
+  }
+
+  static bool Read(bat_ledger::mojom::PublisherInfoDataView in,
+                   ledger::PublisherInfo* out);
+};
+
+template <>
+struct StructTraits<bat_ledger::mojom::ActivityInfoFilterDataView,
+                    ledger::ActivityInfoFilter> {
+  static const std::string& id(const ledger::ActivityInfoFilter& filter) {
+    return filter.id;
+  }
+
+  static int32_t excluded(const ledger::ActivityInfoFilter& filter) {
+    return filter.excluded;
+  }
+
+  static uint32_t percent(const ledger::ActivityInfoFilter& filter) {
+    return filter.percent;
+  }
+
+  static std::vector<bat_ledger::mojom::ActivityInfoFilterOrderPairPtr>
+  order_by(const ledger::ActivityInfoFilter& filter);
+
+  static uint64_t min_duration(const ledger::ActivityInfoFilter& filter) {
+    return filter.min_duration;
+  }
+
+  static uint64_t reconcile_stamp(const ledger::ActivityInfoFilter& filter) {
+    return filter.reconcile_stamp;
+  }
+
+  static bool non_verified(const ledger::ActivityInfoFilter& filter) {
+    return filter.non_verified;
+  }
+
+  static uint32_t min_visits(const ledger::ActivityInfoFilter& filter) {
+    return filter.min_visits;
+  }
+
+  static bool Read(bat_ledger::mojom::ActivityInfoFilterDataView in,
+                   ledger::ActivityInfoFilter* out);
+};
+
+}  // namespace mojo
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_BAT_LEDGER_STRUCT_TRAITS_H_
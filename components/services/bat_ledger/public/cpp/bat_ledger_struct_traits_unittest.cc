@@ -0,0 +1,179 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/bat_ledger_struct_traits.h"
+
+#include <string>
+#include <utility>
+
+#include "mojo/public/cpp/test_support/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerStructTraitsTest.*
+
+namespace bat_ledger {
+
+namespace {
+
+ledger::PublisherInfo CreatePublisherInfo(const std::string& id) {
+  ledger::PublisherInfo info(id);
+  info.duration = 60;
+  info.score = 1.5;
+  info.visits = 3;
+  info.percent = 25;
+  info.weight = 12.5;
+  info.excluded = ledger::PUBLISHER_EXCLUDE::INCLUDED;
+  info.category = ledger::REWARDS_CATEGORY::RECURRING_TIP;
+  info.reconcile_stamp = 1550000000;
+  info.verified = true;
+  info.name = "name";
+  info.url = "https://brave.com";
+  info.provider = "youtube";
+  info.favicon_url = "https://brave.com/favicon.ico";
+  info.contributions.push_back(ledger::ContributionInfo(5.0, 1550000001));
+  info.contributions.back().publisher = id;
+  return info;
+}
+
+}  // namespace
+
+TEST(BatLedgerStructTraitsTest, VisitData) {
+  // Arrange
+  ledger::VisitData input;
+  input.tld = "brave.com";
+  input.domain = "brave.com";
+  input.path = "/about";
+  input.tab_id = 7;
+  input.name = "brave.com";
+  input.url = "https://brave.com/about";
+  input.provider = "youtube";
+  input.favicon_url = "https://brave.com/favicon.ico";
+
+  // Act
+  ledger::VisitData output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::VisitData>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.tld, output.tld);
+  EXPECT_EQ(input.domain, output.domain);
+  EXPECT_EQ(input.path, output.path);
+  EXPECT_EQ(input.tab_id, output.tab_id);
+  EXPECT_EQ(input.name, output.name);
+  EXPECT_EQ(input.url, output.url);
+  EXPECT_EQ(input.provider, output.provider);
+  EXPECT_EQ(input.favicon_url, output.favicon_url);
+}
+
+TEST(BatLedgerStructTraitsTest, PublisherInfo) {
+  // Arrange
+  auto input = CreatePublisherInfo("brave.com");
+
+  // Act
+  ledger::PublisherInfo output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::PublisherInfo>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.id, output.id);
+  EXPECT_EQ(input.duration, output.duration);
+  EXPECT_EQ(input.score, output.score);
+  EXPECT_EQ(input.visits, output.visits);
+  EXPECT_EQ(input.percent, output.percent);
+  EXPECT_EQ(input.weight, output.weight);
+  EXPECT_EQ(input.excluded, output.excluded);
+  EXPECT_EQ(input.category, output.category);
+  EXPECT_EQ(input.reconcile_stamp, output.reconcile_stamp);
+  EXPECT_EQ(input.verified, output.verified);
+  EXPECT_EQ(input.name, output.name);
+  EXPECT_EQ(input.url, output.url);
+  EXPECT_EQ(input.provider, output.provider);
+  EXPECT_EQ(input.favicon_url, output.favicon_url);
+  ASSERT_EQ(input.contributions.size(), output.contributions.size());
+  for (size_t i = 0; i < input.contributions.size(); i++) {
+    EXPECT_EQ(input.contributions.at(i).publisher,
+              output.contributions.at(i).publisher);
+    EXPECT_EQ(input.contributions.at(i).value,
+              output.contributions.at(i).value);
+    EXPECT_EQ(input.contributions.at(i).date,
+              output.contributions.at(i).date);
+  }
+}
+
+TEST(BatLedgerStructTraitsTest, PublisherInfo_InvalidExcluded) {
+  // Arrange
+  auto input = CreatePublisherInfo("brave.com");
+  input.excluded = static_cast<ledger::PUBLISHER_EXCLUDE>(3);
+
+  // Act
+  ledger::PublisherInfo output;
+  const bool result =
+      mojo::test::SerializeAndDeserialize<mojom::PublisherInfo>(
+          &input, &output);
+
+  // Assert
+  EXPECT_FALSE(result);
+}
+
+TEST(BatLedgerStructTraitsTest, PublisherInfo_InvalidCategory) {
+  // Arrange
+  auto input = CreatePublisherInfo("brave.com");
+  input.category = static_cast<ledger::REWARDS_CATEGORY>(1 << 5);
+
+  // Act
+  ledger::PublisherInfo output;
+  const bool result =
+      mojo::test::SerializeAndDeserialize<mojom::PublisherInfo>(
+          &input, &output);
+
+  // Assert
+  EXPECT_FALSE(result);
+}
+
+TEST(BatLedgerStructTraitsTest, ActivityInfoFilter) {
+  // Arrange
+  ledger::ActivityInfoFilter input;
+  input.id = "brave.com";
+  input.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL_EXCEPT_EXCLUDED;
+  input.percent = 1;
+  input.order_by.push_back(std::make_pair("percent", false));
+  input.order_by.push_back(std::make_pair("visits", true));
+  input.min_duration = 8;
+  input.reconcile_stamp = 1550000000;
+  input.non_verified = true;
+  input.min_visits = 2;
+
+  // Act
+  ledger::ActivityInfoFilter output;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::ActivityInfoFilter>(
+      &input, &output));
+
+  // Assert
+  EXPECT_EQ(input.id, output.id);
+  EXPECT_EQ(input.excluded, output.excluded);
+  EXPECT_EQ(input.percent, output.percent);
+  EXPECT_EQ(input.order_by, output.order_by);
+  EXPECT_EQ(input.min_duration, output.min_duration);
+  EXPECT_EQ(input.reconcile_stamp, output.reconcile_stamp);
+  EXPECT_EQ(input.non_verified, output.non_verified);
+  EXPECT_EQ(input.min_visits, output.min_visits);
+}
+
+TEST(BatLedgerStructTraitsTest, ActivityInfoFilter_InvalidExcluded) {
+  // Arrange
+  ledger::ActivityInfoFilter input;
+  input.excluded = static_cast<ledger::EXCLUDE_FILTER>(4);
+
+  // Act
+  ledger::ActivityInfoFilter output;
+  const bool result =
+      mojo::test::SerializeAndDeserialize<mojom::ActivityInfoFilter>(
+          &input, &output);
+
+  // Assert
+  EXPECT_FALSE(result);
+}
+
+}  // namespace bat_ledger
@@ -6,6 +6,7 @@
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
 
 #include "base/logging.h"
+#include "base/optional.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 using std::placeholders::_1;
@@ -38,6 +39,15 @@ ledger::URL_METHOD ToLedgerURLMethod(int32_t method) {
   return (ledger::URL_METHOD)method;
 }
 
+base::Optional<ledger::PublisherInfo> ToMojomPublisherInfo(
+    const std::unique_ptr<ledger::PublisherInfo>& info) {
+  if (!info) {
+    return base::nullopt;
+  }
+
+  return *info;
+}
+
 }  // namespace
 
 LedgerClientMojoProxy::LedgerClientMojoProxy(
@@ -127,8 +137,10 @@ template <>
 void LedgerClientMojoProxy::CallbackHolder<
   LedgerClientMojoProxy::LoadPublisherListCallback>::OnPublisherListLoaded(
     ledger::Result result, const std::string& data) {
-  if (is_valid())
-    std::move(callback_).Run(ToMojomResult(result), data);
+  if (is_valid()) {
+    std::move(callback_).Run(ToMojomResult(result),
+        std::vector<uint8_t>(data.begin(), data.end()));
+  }
   delete this;
 }
 
@@ -139,6 +151,14 @@ void LedgerClientMojoProxy::SaveLedgerState(
   ledger_client_->SaveLedgerState(ledger_state, holder);
 }
 
+void LedgerClientMojoProxy::AppendLedgerState(
+    const std::string& ledger_state, AppendLedgerStateCallback callback) {
+  // Completes through OnLedgerStateSaved, like SaveLedgerState.
+  auto* holder = new CallbackHolder<AppendLedgerStateCallback>(
+      AsWeakPtr(), std::move(callback));
+  ledger_client_->AppendLedgerState(ledger_state, holder);
+}
+
 template <typename Callback>
 void LedgerClientMojoProxy::CallbackHolder<Callback>::OnLedgerStateSaved(
     ledger::Result result) {
@@ -177,10 +197,23 @@ void LedgerClientMojoProxy::CallbackHolder<
 }
 
 void LedgerClientMojoProxy::SavePublishersList(
-    const std::string& publishers_list, SavePublishersListCallback callback) {
+    const std::vector<uint8_t>& publishers_list,
+    SavePublishersListCallback callback) {
   auto* holder = new CallbackHolder<SavePublishersListCallback>(
       AsWeakPtr(), std::move(callback));
-  ledger_client_->SavePublishersList(publishers_list, holder);
+  ledger_client_->SavePublishersList(
+      std::string(publishers_list.begin(), publishers_list.end()), holder);
+}
+
+void LedgerClientMojoProxy::AppendPublishersListDelta(
+    const std::vector<uint8_t>& publishers_list_delta,
+    AppendPublishersListDeltaCallback callback) {
+  // Completes through OnPublishersListSaved, like SavePublishersList.
+  auto* holder = new CallbackHolder<AppendPublishersListDeltaCallback>(
+      AsWeakPtr(), std::move(callback));
+  ledger_client_->AppendPublishersListDelta(
+      std::string(publishers_list_delta.begin(), publishers_list_delta.end()),
+      holder);
 }
 
 template <typename Callback>
@@ -236,25 +269,20 @@ void LedgerClientMojoProxy::OnSavePublisherInfo(
     CallbackHolder<SavePublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
 void LedgerClientMojoProxy::SavePublisherInfo(
-    const std::string& publisher_info,
+    const ledger::PublisherInfo& publisher_info,
     SavePublisherInfoCallback callback) {
   // deleted in OnSavePublisherInfo
   auto* holder = new CallbackHolder<SavePublisherInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  ledger_client_->SavePublisherInfo(std::move(info),
+  ledger_client_->SavePublisherInfo(
+      std::make_unique<ledger::PublisherInfo>(publisher_info),
       std::bind(LedgerClientMojoProxy::OnSavePublisherInfo, holder, _1, _2));
 }
 
@@ -263,9 +291,9 @@ void LedgerClientMojoProxy::OnLoadPublisherInfo(
     CallbackHolder<LoadPublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
@@ -283,20 +311,19 @@ void LedgerClientMojoProxy::LoadPublisherInfo(
 void LedgerClientMojoProxy::OnLoadPanelPublisherInfo(
     CallbackHolder<LoadPanelPublisherInfoCallback>* holder,
     ledger::Result result, std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
-void LedgerClientMojoProxy::LoadPanelPublisherInfo(const std::string& filter,
+void LedgerClientMojoProxy::LoadPanelPublisherInfo(
+    const ledger::ActivityInfoFilter& filter,
     LoadPanelPublisherInfoCallback callback) {
   // deleted in OnLoadPanelPublisherInfo
   auto* holder = new CallbackHolder<LoadPanelPublisherInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-  ledger_client_->LoadPanelPublisherInfo(publisher_info_filter,
+  ledger_client_->LoadPanelPublisherInfo(filter,
       std::bind(LedgerClientMojoProxy::OnLoadPanelPublisherInfo,
         holder, _1, _2));
 }
@@ -306,9 +333,9 @@ void LedgerClientMojoProxy::OnLoadMediaPublisherInfo(
     CallbackHolder<LoadMediaPublisherInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
@@ -343,11 +370,10 @@ void LedgerClientMojoProxy::OnExcludedSitesChanged(
 }
 
 void LedgerClientMojoProxy::OnPanelPublisherInfo(int32_t result,
-    const std::string& info, uint64_t window_id) {
+    const base::Optional<ledger::PublisherInfo>& info, uint64_t window_id) {
   std::unique_ptr<ledger::PublisherInfo> publisher_info;
-  if (!info.empty()) {
-    publisher_info.reset(new ledger::PublisherInfo());
-    publisher_info->loadFromJson(info);
+  if (info) {
+    publisher_info = std::make_unique<ledger::PublisherInfo>(*info);
   }
   ledger_client_->OnPanelPublisherInfo(ToLedgerResult(result),
       std::move(publisher_info), window_id);
@@ -376,13 +402,8 @@ void LedgerClientMojoProxy::OnGetRecurringTips(
     CallbackHolder<GetRecurringTipsCallback>* holder,
     const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  std::vector<std::string> list;
-  for (const auto& publisher_info : publisher_info_list) {
-    list.push_back(publisher_info.ToJson());
-  }
-
   if (holder->is_valid())
-    std::move(holder->get()).Run(list, next_record);
+    std::move(holder->get()).Run(publisher_info_list, next_record);
   delete holder;
 }
 
@@ -499,21 +520,19 @@ void LedgerClientMojoProxy::OnLoadActivityInfo(
     CallbackHolder<LoadActivityInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
 void LedgerClientMojoProxy::LoadActivityInfo(
-    const std::string& filter,
+    const ledger::ActivityInfoFilter& filter,
     LoadActivityInfoCallback callback) {
   // deleted in OnLoadActivityInfo
   auto* holder = new CallbackHolder<LoadActivityInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-  ledger_client_->LoadActivityInfo(publisher_info_filter,
+  ledger_client_->LoadActivityInfo(filter,
       std::bind(LedgerClientMojoProxy::OnLoadActivityInfo, holder, _1, _2));
 }
 
@@ -522,25 +541,20 @@ void LedgerClientMojoProxy::OnSaveActivityInfo(
     CallbackHolder<SaveActivityInfoCallback>* holder,
     ledger::Result result,
     std::unique_ptr<ledger::PublisherInfo> info) {
-  std::string json_info = info ? info->ToJson() : "";
   if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), json_info);
+    std::move(holder->get()).Run(ToMojomResult(result),
+                                 ToMojomPublisherInfo(info));
   delete holder;
 }
 
 void LedgerClientMojoProxy::SaveActivityInfo(
-    const std::string& publisher_info,
+    const ledger::PublisherInfo& publisher_info,
     SaveActivityInfoCallback callback) {
   // deleted in OnSaveActivityInfo
   auto* holder = new CallbackHolder<SaveActivityInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  std::unique_ptr<ledger::PublisherInfo> info;
-  if (!publisher_info.empty()) {
-    info.reset(new ledger::PublisherInfo());
-    info->loadFromJson(publisher_info);
-  }
-
-  ledger_client_->SaveActivityInfo(std::move(info),
+  ledger_client_->SaveActivityInfo(
+      std::make_unique<ledger::PublisherInfo>(publisher_info),
       std::bind(LedgerClientMojoProxy::OnSaveActivityInfo, holder, _1, _2));
 }
 
@@ -568,30 +582,22 @@ void LedgerClientMojoProxy::OnGetActivityInfoList(
     CallbackHolder<GetActivityInfoListCallback>* holder,
     const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  std::vector<std::string> list;
-  for (const auto& publisher_info : publisher_info_list) {
-    list.push_back(publisher_info.ToJson());
-  }
-
   if (holder->is_valid())
-    std::move(holder->get()).Run(list, next_record);
+    std::move(holder->get()).Run(publisher_info_list, next_record);
   delete holder;
 }
 
 void LedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
     uint32_t limit,
-    const std::string& filter,
+    const ledger::ActivityInfoFilter& filter,
     GetActivityInfoListCallback callback) {
   // deleted in OnGetActivityInfoList
   auto* holder = new CallbackHolder<GetActivityInfoListCallback>(
       AsWeakPtr(), std::move(callback));
 
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-
   ledger_client_->GetActivityInfoList(start,
       limit,
-      publisher_info_filter,
+      filter,
       std::bind(LedgerClientMojoProxy::OnGetActivityInfoList,
                 holder,
                 _1,
@@ -599,10 +605,9 @@ void LedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
 }
 
 void LedgerClientMojoProxy::SaveNormalizedPublisherList(
-    const std::string& normalized_list) {
-
+    const std::vector<ledger::PublisherInfo>& normalized_list) {
   ledger::PublisherInfoListStruct list;
-  list.loadFromJson(normalized_list);
+  list.list = normalized_list;
 
   ledger_client_->SaveNormalizedPublisherList(list);
 }
@@ -704,13 +709,8 @@ void LedgerClientMojoProxy::OnGetOneTimeTips(
     CallbackHolder<GetOneTimeTipsCallback>* holder,
     const ledger::PublisherInfoList& publisher_info_list,
     uint32_t next_record) {
-  std::vector<std::string> list;
-  for (const auto& publisher_info : publisher_info_list) {
-    list.push_back(publisher_info.ToJson());
-  }
-
   if (holder->is_valid())
-    std::move(holder->get()).Run(list, next_record);
+    std::move(holder->get()).Run(publisher_info_list, next_record);
   delete holder;
 }
 
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 
@@ -42,16 +43,21 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void LoadPublisherList(LoadPublisherListCallback callback) override;
   void SaveLedgerState(const std::string& ledger_state,
       SaveLedgerStateCallback callback) override;
+  void AppendLedgerState(const std::string& ledger_state,
+      AppendLedgerStateCallback callback) override;
   void SavePublisherState(const std::string& publisher_state,
       SavePublisherStateCallback callback) override;
-  void SavePublishersList(const std::string& publishers_list,
+  void SavePublishersList(const std::vector<uint8_t>& publishers_list,
       SavePublishersListCallback callback) override;
+  void AppendPublishersListDelta(
+      const std::vector<uint8_t>& publishers_list_delta,
+      AppendPublishersListDeltaCallback callback) override;
 
-  void SavePublisherInfo(const std::string& publisher_info,
+  void SavePublisherInfo(const ledger::PublisherInfo& publisher_info,
       SavePublisherInfoCallback callback) override;
   void LoadPublisherInfo(const std::string& publisher_key,
       LoadPublisherInfoCallback callback) override;
-  void LoadPanelPublisherInfo(const std::string& filter,
+  void LoadPanelPublisherInfo(const ledger::ActivityInfoFilter& filter,
       LoadPanelPublisherInfoCallback callback) override;
   void LoadMediaPublisherInfo(const std::string& media_key,
       LoadMediaPublisherInfoCallback callback) override;
@@ -68,7 +74,8 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
 
   void SetTimer(uint64_t time_offset, SetTimerCallback callback) override;
   void KillTimer(const uint32_t timer_id) override;
-  void OnPanelPublisherInfo(int32_t result, const std::string& info,
+  void OnPanelPublisherInfo(int32_t result,
+      const base::Optional<ledger::PublisherInfo>& info,
       uint64_t window_id) override;
   void OnExcludedSitesChanged(const std::string& publisher_id,
                               int exclude) override;
@@ -96,21 +103,21 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void SavePendingContribution(
       const std::string& list) override;
 
-  void LoadActivityInfo(const std::string& filter,
+  void LoadActivityInfo(const ledger::ActivityInfoFilter& filter,
       LoadActivityInfoCallback callback) override;
 
-  void SaveActivityInfo(const std::string& publisher_info,
+  void SaveActivityInfo(const ledger::PublisherInfo& publisher_info,
       SaveActivityInfoCallback callback) override;
 
   void OnRestorePublishers(OnRestorePublishersCallback callback) override;
 
   void GetActivityInfoList(uint32_t start,
                            uint32_t limit,
-                           const std::string& filter,
+                           const ledger::ActivityInfoFilter& filter,
                            GetActivityInfoListCallback callback) override;
 
   void SaveNormalizedPublisherList(
-    const std::string& normalized_list) override;
+    const std::vector<ledger::PublisherInfo>& normalized_list) override;
   void SaveState(const std::string& name,
                               const std::string& value,
                               SaveStateCallback callback) override;